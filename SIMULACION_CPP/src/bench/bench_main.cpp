@@ -0,0 +1,450 @@
+/*
+ * bench_main.cpp
+ *
+ * Microbenchmarks de cada operación de GestorDisco, para detectar
+ * regresiones de velocidad al tocar una estructura (make bench).
+ *
+ * QUÉ SE MIDE (por estructura × tamaño de disco × ocupación):
+ *  allocar        pedidos de 1-32 bloques
+ *  liberar        las mismas extensiones, en orden inverso
+ *  buscar_mayor   buscar_bloque_mas_grande()
+ *  fragmentacion  get_fragmentacion()
+ *  cargar_binario cargar_estado() del formato binario (mmap)
+ *  cargar_texto   cargar_estado() del formato texto
+ *  constructor    crear_gestor() + destruirlo
+ *  reconstruir    copiar_estado() de un disco ocupado bloque a bloque al
+ *                 azar (lo más fragmentado posible): mide reconstruir()
+ *
+ * CÓMO SE MIDE:
+ * - El disco se lleva a la ocupación con llenar_disco() (API propia de
+ *   cada estructura, semilla fija: mismo punto de partida siempre).
+ *   reconstruir no lo necesita: con --filtro reconstruir se puede medir
+ *   en discos donde llenar_disco tardaría demasiado (10^8 bloques)
+ * - Calibración: se duplican las iteraciones hasta que una muestra dure
+ *   --tiempo-min ms; esa pasada hace de calentamiento
+ * - Luego --muestras muestras; se informa la mediana de ns/op, el mínimo
+ *   y la dispersión (máx - mín) / mediana
+ * - allocar y liberar se miden en tandas que no superan la mitad del
+ *   espacio libre; lo que deshace cada tanda queda fuera del reloj, así
+ *   todas las muestras parten del mismo estado
+ *
+ * La salida no depende del orden ni de la hora: dos corridas en la
+ * misma máquina se comparan con diff (o con --csv, en una planilla).
+ */
+
+#include "core/disk_manager.h"
+#include "experimentos/experimentos.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const unsigned SEMILLA = 4242;
+const size_t TANDA_MAXIMA = 4096;
+const char *ARCHIVO_BINARIO = "data/bench_estado.bin";
+const char *ARCHIVO_TEXTO = "data/bench_estado.txt";
+
+struct OpcionesBench
+{
+    std::vector<IndiceBloque> tamanios = {16384, 1048576};
+    std::vector<float> ocupaciones = {0.5f, 0.9f};
+    double tiempo_minimo_ms = 20.0;
+    int muestras = 5;
+    std::string filtro; // Solo los casos "estructura/operación" que lo contengan
+    bool csv = false;
+};
+
+// Cuerpo de un benchmark: hace `iteraciones` operaciones y devuelve los
+// ns que cuentan (preparar y deshacer quedan fuera)
+typedef std::function<uint64_t(uint64_t iteraciones)> Cuerpo;
+
+struct Medicion
+{
+    double mediana_ns;
+    double minimo_ns;
+    double dispersion; // Porcentaje de la mediana
+    uint64_t iteraciones;
+};
+
+uint64_t ns_desde(std::chrono::steady_clock::time_point comienzo)
+{
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(fin - comienzo).count();
+}
+
+Medicion medir(const Cuerpo &cuerpo, const OpcionesBench &opciones)
+{
+    const double objetivo_ns = opciones.tiempo_minimo_ms * 1e6;
+
+    // Calibrar (y calentar): ir hacia el número de iteraciones que llena
+    // el tiempo mínimo, a lo sumo ×100 por paso
+    uint64_t iteraciones = 1;
+    while (true)
+    {
+        uint64_t ns = cuerpo(iteraciones);
+        if (ns >= objetivo_ns || iteraciones >= (uint64_t(1) << 30))
+            break;
+        uint64_t estimado = ns > 0 ? static_cast<uint64_t>(iteraciones * objetivo_ns * 1.2 / ns)
+                                   : iteraciones * 100;
+        iteraciones = std::max(iteraciones * 2, std::min(estimado, iteraciones * 100));
+    }
+
+    std::vector<double> por_operacion;
+    for (int m = 0; m < opciones.muestras; m++)
+        por_operacion.push_back(static_cast<double>(cuerpo(iteraciones)) / iteraciones);
+    std::sort(por_operacion.begin(), por_operacion.end());
+
+    Medicion medicion;
+    medicion.mediana_ns = por_operacion[por_operacion.size() / 2];
+    medicion.minimo_ns = por_operacion.front();
+    medicion.dispersion = medicion.mediana_ns > 0.0
+                              ? (por_operacion.back() - por_operacion.front()) / medicion.mediana_ns * 100.0
+                              : 0.0;
+    medicion.iteraciones = iteraciones;
+    return medicion;
+}
+
+// guardar_estado / cargar_estado avisan por std::cout: callarlos mientras
+// se mide (el aviso no es parte de la operación)
+class SilenciarSalida
+{
+private:
+    std::ostringstream descarte;
+    std::streambuf *anterior;
+
+public:
+    SilenciarSalida() : anterior(std::cout.rdbuf(descarte.rdbuf())) {}
+    ~SilenciarSalida() { std::cout.rdbuf(anterior); }
+};
+
+// ============================================================================
+// CUERPOS
+// ============================================================================
+
+// Tandas de allocaciones (medir_allocar) o de liberaciones de lo recién
+// allocado; la otra mitad de cada tanda se hace fuera del reloj
+uint64_t tandas_allocar_liberar(GestorDisco &gestor, const std::vector<IndiceBloque> &tamanios,
+                                size_t tanda_maxima, uint64_t iteraciones, bool medir_allocar)
+{
+    std::vector<IndiceBloque> inicios(tanda_maxima);
+    uint64_t total_ns = 0;
+    uint64_t hechas = 0;
+
+    while (hechas < iteraciones)
+    {
+        size_t tanda = static_cast<size_t>(std::min<uint64_t>(iteraciones - hechas, tanda_maxima));
+
+        auto comienzo = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < tanda; i++)
+            inicios[i] = gestor.allocar(tamanios[i]);
+        if (medir_allocar)
+            total_ns += ns_desde(comienzo);
+
+        comienzo = std::chrono::steady_clock::now();
+        for (size_t i = tanda; i-- > 0;)
+        {
+            if (inicios[i] != -1)
+                gestor.liberar(inicios[i], tamanios[i]);
+        }
+        if (!medir_allocar)
+            total_ns += ns_desde(comienzo);
+
+        hechas += tanda;
+    }
+    return total_ns;
+}
+
+struct Caso
+{
+    const char *operacion;
+    Cuerpo cuerpo;
+};
+
+void imprimir_encabezado(const OpcionesBench &opciones)
+{
+    if (opciones.csv)
+    {
+        std::cout << "bloques,ocupacion,estructura,operacion,ns_mediana,ns_minimo,dispersion_pct,iteraciones\n";
+        return;
+    }
+
+    std::cout << "Microbenchmarks de GestorDisco (" << opciones.muestras << " muestras de al menos "
+              << opciones.tiempo_minimo_ms << " ms; ns por operación)\n\n";
+    std::cout << std::left << std::setw(10) << "Bloques"
+              << std::setw(7) << "Ocup"
+              << std::setw(25) << "Estructura"
+              << std::setw(17) << "Operación" // ó ocupa 2 bytes
+              << std::setw(14) << "ns/op"
+              << std::setw(14) << "Mínimo"     // í ocupa 2 bytes
+              << std::setw(10) << "Disp(%)"
+              << "Iteraciones\n";
+    std::cout << std::string(106, '-') << "\n";
+}
+
+void imprimir_medicion(const OpcionesBench &opciones, IndiceBloque bloques, float ocupacion,
+                       const std::string &estructura, const char *operacion, const Medicion &m)
+{
+    if (opciones.csv)
+    {
+        std::cout << bloques << "," << ocupacion << "," << estructura << "," << operacion << ","
+                  << std::fixed << std::setprecision(2) << m.mediana_ns << "," << m.minimo_ns << ","
+                  << std::setprecision(1) << m.dispersion << "," << m.iteraciones << "\n";
+        return;
+    }
+
+    std::cout << std::left << std::setw(10) << bloques
+              << std::fixed << std::setprecision(2) << std::setw(7) << ocupacion
+              << std::setw(25) << estructura
+              << std::setw(16) << operacion
+              << std::setw(14) << m.mediana_ns
+              << std::setw(13) << m.minimo_ns
+              << std::setprecision(1) << std::setw(10) << m.dispersion
+              << m.iteraciones << "\n";
+}
+
+// Todos los casos de una estructura sobre un disco de `bloques` a la
+// `ocupacion` pedida
+
+bool pasa_filtro(const OpcionesBench &opciones, const std::string &nombre, const char *operacion)
+{
+    return (nombre + "/" + operacion).find(opciones.filtro) != std::string::npos;
+}
+
+void correr_estructura(const OpcionesBench &opciones, size_t indice, IndiceBloque bloques, float ocupacion)
+{
+    // Los gestores de `bloques` se crean recién si algún caso pasa el
+    // filtro: con discos muy grandes algunas estructuras no entran en memoria
+    std::string nombre = crear_gestor(indice, 1, TAMANIO_BLOQUE)->obtener_nombre();
+    std::unique_ptr<GestorDisco> gestor;
+    std::unique_ptr<GestorDisco> destino;
+
+    size_t tanda_maxima = 1;
+    std::vector<IndiceBloque> tamanios;
+    volatile IndiceBloque sumidero_bloques = 0;
+    volatile float sumidero_fragmentacion = 0.0f;
+
+    std::vector<Caso> casos = {
+        {"allocar", [&](uint64_t n)
+         { return tandas_allocar_liberar(*gestor, tamanios, tanda_maxima, n, true); }},
+        {"liberar", [&](uint64_t n)
+         { return tandas_allocar_liberar(*gestor, tamanios, tanda_maxima, n, false); }},
+        {"buscar_mayor", [&](uint64_t n)
+         {
+             auto comienzo = std::chrono::steady_clock::now();
+             for (uint64_t i = 0; i < n; i++)
+                 sumidero_bloques = gestor->buscar_bloque_mas_grande();
+             return ns_desde(comienzo);
+         }},
+        {"fragmentacion", [&](uint64_t n)
+         {
+             auto comienzo = std::chrono::steady_clock::now();
+             for (uint64_t i = 0; i < n; i++)
+                 sumidero_fragmentacion = gestor->get_fragmentacion();
+             return ns_desde(comienzo);
+         }},
+        {"cargar_binario", [&](uint64_t n)
+         {
+             SilenciarSalida silencio;
+             auto comienzo = std::chrono::steady_clock::now();
+             for (uint64_t i = 0; i < n; i++)
+                 destino->cargar_estado(ARCHIVO_BINARIO);
+             return ns_desde(comienzo);
+         }},
+        {"cargar_texto", [&](uint64_t n)
+         {
+             SilenciarSalida silencio;
+             auto comienzo = std::chrono::steady_clock::now();
+             for (uint64_t i = 0; i < n; i++)
+                 destino->cargar_estado(ARCHIVO_TEXTO);
+             return ns_desde(comienzo);
+         }},
+        {"constructor", [&](uint64_t n)
+         {
+             auto comienzo = std::chrono::steady_clock::now();
+             for (uint64_t i = 0; i < n; i++)
+                 sumidero_bloques = crear_gestor(indice, bloques, TAMANIO_BLOQUE)->get_bloques_libres();
+             return ns_desde(comienzo);
+         }},
+    };
+
+    casos.erase(std::remove_if(casos.begin(), casos.end(), [&](const Caso &caso)
+                               { return !pasa_filtro(opciones, nombre, caso.operacion); }),
+                casos.end());
+    if (casos.empty())
+        return; // Nada que medir: no vale la pena llenar el disco
+
+    gestor = crear_gestor(indice, bloques, TAMANIO_BLOQUE);
+    gestor->set_dispositivo(crear_modelo_dispositivo("nulo"));
+    destino = crear_gestor(indice, bloques, TAMANIO_BLOQUE);
+
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas vivas;
+    llenar_disco(*gestor, ocupacion, gen, vivas);
+
+    // Pedidos fijos; una tanda pide a lo sumo la mitad del espacio libre
+    tanda_maxima = std::max<size_t>(1, std::min<size_t>(TANDA_MAXIMA, gestor->get_bloques_libres() / 64));
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+    tamanios.resize(tanda_maxima);
+    for (IndiceBloque &tamanio : tamanios)
+        tamanio = dist_tam(gen);
+
+    {
+        SilenciarSalida silencio;
+        gestor->guardar_estado(ARCHIVO_BINARIO);
+        gestor->guardar_estado(ARCHIVO_TEXTO, TEXTO);
+    }
+
+    for (const Caso &caso : casos)
+    {
+        Medicion m = medir(caso.cuerpo, opciones);
+        imprimir_medicion(opciones, bloques, ocupacion, nombre, caso.operacion, m);
+    }
+}
+
+// reconstruir: copiar_estado() desde `plantilla`, un MapaDeBits con cada
+// bloque ocupado al azar (inicializar_disco). Ahí casi todas las palabras
+// tienen varias rachas: el peor caso para armar el índice de huecos.
+// La plantilla se crea una vez por tamaño y ocupación, con el primero
+// que la necesite.
+
+void correr_reconstruccion(const OpcionesBench &opciones, size_t indice, IndiceBloque bloques,
+                           float ocupacion, std::unique_ptr<MapaDeBits> &plantilla)
+{
+    std::string nombre = crear_gestor(indice, 1, TAMANIO_BLOQUE)->obtener_nombre();
+    if (!pasa_filtro(opciones, nombre, "reconstruir"))
+        return;
+
+    if (plantilla == nullptr)
+    {
+        SilenciarSalida silencio;
+        plantilla = std::make_unique<MapaDeBits>(bloques, TAMANIO_BLOQUE);
+        plantilla->inicializar_disco(ocupacion, SEMILLA);
+    }
+
+    auto destino = crear_gestor(indice, bloques, TAMANIO_BLOQUE);
+    Cuerpo cuerpo = [&](uint64_t n)
+    {
+        auto comienzo = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < n; i++)
+            destino->copiar_estado(*plantilla);
+        return ns_desde(comienzo);
+    };
+
+    Medicion m = medir(cuerpo, opciones);
+    imprimir_medicion(opciones, bloques, ocupacion, nombre, "reconstruir", m);
+}
+
+// Lista separada por comas: "16384,1048576"
+template <typename T>
+bool leer_lista(const char *texto, std::vector<T> &valores)
+{
+    valores.clear();
+    std::stringstream entrada(texto);
+    std::string elemento;
+    while (std::getline(entrada, elemento, ','))
+    {
+        char *fin = nullptr;
+        double valor = std::strtod(elemento.c_str(), &fin);
+        if (elemento.empty() || *fin != '\0')
+            return false;
+        valores.push_back(static_cast<T>(valor));
+    }
+    return !valores.empty();
+}
+
+// Opciones: --bloques N,N,...  --ocupacion F,F,...  --tiempo-min MS
+//           --muestras N  --filtro TEXTO  --csv
+bool leer_opciones(int argc, char *argv[], OpcionesBench &opciones)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string opcion = argv[i];
+        if (opcion == "--csv")
+        {
+            opciones.csv = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Falta el valor de la opción " << opcion << "\n";
+            return false;
+        }
+        const char *valor = argv[++i];
+
+        bool valido = true;
+        if (opcion == "--bloques")
+            valido = leer_lista(valor, opciones.tamanios);
+        else if (opcion == "--ocupacion")
+            valido = leer_lista(valor, opciones.ocupaciones);
+        else if (opcion == "--tiempo-min")
+            opciones.tiempo_minimo_ms = std::strtod(valor, nullptr);
+        else if (opcion == "--muestras")
+            opciones.muestras = std::atoi(valor);
+        else if (opcion == "--filtro")
+            opciones.filtro = valor;
+        else
+        {
+            std::cerr << "Opción desconocida: " << opcion << "\n";
+            return false;
+        }
+        if (!valido)
+        {
+            std::cerr << "Lista inválida: " << valor << "\n";
+            return false;
+        }
+    }
+
+    for (IndiceBloque bloques : opciones.tamanios)
+    {
+        if (bloques <= 0)
+            return false;
+    }
+    for (float ocupacion : opciones.ocupaciones)
+    {
+        if (ocupacion < 0.0f || ocupacion > 1.0f)
+            return false;
+    }
+    return opciones.tiempo_minimo_ms > 0.0 && opciones.muestras > 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    OpcionesBench opciones;
+    if (!leer_opciones(argc, argv, opciones))
+    {
+        std::cerr << "Uso: " << argv[0]
+                  << " [--bloques N,N,...] [--ocupacion F,F,...] [--tiempo-min MS]"
+                  << " [--muestras N] [--filtro TEXTO] [--csv]\n";
+        return 1;
+    }
+
+    imprimir_encabezado(opciones);
+
+    for (IndiceBloque bloques : opciones.tamanios)
+    {
+        for (float ocupacion : opciones.ocupaciones)
+        {
+            std::unique_ptr<MapaDeBits> plantilla;
+            for (size_t indice = 0; indice < NUM_ESTRUCTURAS; indice++)
+            {
+                correr_estructura(opciones, indice, bloques, ocupacion);
+                correr_reconstruccion(opciones, indice, bloques, ocupacion, plantilla);
+            }
+        }
+    }
+
+    std::remove(ARCHIVO_BINARIO);
+    std::remove(ARCHIVO_TEXTO);
+    return 0;
+}
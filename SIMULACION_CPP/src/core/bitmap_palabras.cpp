@@ -0,0 +1,299 @@
+/*
+ * bitmap_palabras.cpp
+ *
+ * Implementación del mapa de bits por palabras. Todas las operaciones
+ * de rango trabajan palabra por palabra: la primera y la última se
+ * tratan con máscaras parciales y las intermedias completas.
+ */
+
+#include "bitmap_palabras.h"
+#include <algorithm>
+
+static const uint64_t PALABRA_LLENA = ~0ULL;
+
+BitmapPalabras::BitmapPalabras(int64_t num_bits)
+    : palabras(nullptr), cantidad_palabras(0), num_bits(0)
+{
+    redimensionar(num_bits);
+}
+
+// Copias: siempre a palabras propias (aunque el original sea externo)
+
+BitmapPalabras::BitmapPalabras(const BitmapPalabras &otro)
+    : palabras(nullptr),
+      cantidad_palabras(otro.cantidad_palabras),
+      num_bits(otro.num_bits),
+      propias(otro.palabras, otro.palabras + otro.cantidad_palabras)
+{
+    palabras = propias.data();
+}
+
+BitmapPalabras::BitmapPalabras(BitmapPalabras &&otro) noexcept
+    : palabras(otro.palabras),
+      cantidad_palabras(otro.cantidad_palabras),
+      num_bits(otro.num_bits),
+      propias(std::move(otro.propias)), // El buffer se mueve, `palabras` sigue valiendo
+      externo(std::move(otro.externo))
+{
+    otro.palabras = nullptr;
+    otro.cantidad_palabras = 0;
+    otro.num_bits = 0;
+}
+
+BitmapPalabras &BitmapPalabras::operator=(const BitmapPalabras &otro)
+{
+    if (this != &otro)
+    {
+        propias.assign(otro.palabras, otro.palabras + otro.cantidad_palabras);
+        externo.reset();
+        palabras = propias.data();
+        cantidad_palabras = otro.cantidad_palabras;
+        num_bits = otro.num_bits;
+    }
+    return *this;
+}
+
+BitmapPalabras &BitmapPalabras::operator=(BitmapPalabras &&otro) noexcept
+{
+    if (this != &otro)
+    {
+        propias = std::move(otro.propias);
+        externo = std::move(otro.externo);
+        palabras = otro.palabras;
+        cantidad_palabras = otro.cantidad_palabras;
+        num_bits = otro.num_bits;
+        otro.palabras = nullptr;
+        otro.cantidad_palabras = 0;
+        otro.num_bits = 0;
+    }
+    return *this;
+}
+
+uint64_t BitmapPalabras::mascara_rango(int desde, int hasta)
+{
+    // hasta - desde en [1, 64]; evitar el desplazamiento indefinido por 64
+    uint64_t ancho = static_cast<uint64_t>(hasta - desde);
+    uint64_t base = (ancho == 64) ? PALABRA_LLENA : ((1ULL << ancho) - 1);
+    return base << desde;
+}
+
+void BitmapPalabras::sellar_relleno()
+{
+    int usados = static_cast<int>(num_bits % BITS_POR_PALABRA);
+    if (usados != 0)
+    {
+        palabras[cantidad_palabras - 1] |= mascara_rango(usados, BITS_POR_PALABRA);
+    }
+}
+
+void BitmapPalabras::redimensionar(int64_t nuevos_bits)
+{
+    num_bits = nuevos_bits;
+    propias.assign((nuevos_bits + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA, 0);
+    externo.reset();
+    palabras = propias.data();
+    cantidad_palabras = static_cast<int64_t>(propias.size());
+    sellar_relleno();
+}
+
+void BitmapPalabras::adoptar(uint64_t *datos, int64_t nuevos_bits, std::shared_ptr<void> dueno)
+{
+    propias.clear();
+    propias.shrink_to_fit();
+    externo = std::move(dueno);
+    palabras = datos;
+    num_bits = nuevos_bits;
+    cantidad_palabras = (nuevos_bits + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA;
+    sellar_relleno();
+}
+
+void BitmapPalabras::asignar(int64_t i, bool ocupado)
+{
+    uint64_t bit = 1ULL << (i % BITS_POR_PALABRA);
+    if (ocupado)
+        palabras[i / BITS_POR_PALABRA] |= bit;
+    else
+        palabras[i / BITS_POR_PALABRA] &= ~bit;
+}
+
+/*
+ * MARCAR_RANGO / LIMPIAR_RANGO
+ *
+ * EJEMPLO (palabras de 8 bits para simplificar):
+ * rango [6, 19) →  palabra 0: bits 6-7  (máscara parcial)
+ *                  palabra 1: completa  (máscara llena)
+ *                  palabra 2: bits 0-2  (máscara parcial)
+ *
+ * El número de bits que cambian se obtiene con popcount de la máscara
+ * aplicada al valor anterior, así los contadores quedan exactos aunque
+ * el rango ya estuviera parcialmente ocupado/libre.
+ */
+int64_t BitmapPalabras::marcar_rango(int64_t inicio, int64_t cantidad)
+{
+    int64_t cambiados = 0;
+    int64_t fin = inicio + cantidad;
+
+    while (inicio < fin)
+    {
+        int64_t idx = inicio / BITS_POR_PALABRA;
+        int desde = static_cast<int>(inicio % BITS_POR_PALABRA);
+        int hasta = static_cast<int>(std::min<int64_t>(BITS_POR_PALABRA, fin - idx * BITS_POR_PALABRA));
+        uint64_t mascara = mascara_rango(desde, hasta);
+
+        cambiados += __builtin_popcountll(mascara & ~palabras[idx]);
+        palabras[idx] |= mascara;
+        inicio = idx * BITS_POR_PALABRA + hasta;
+    }
+
+    return cambiados;
+}
+
+int64_t BitmapPalabras::limpiar_rango(int64_t inicio, int64_t cantidad)
+{
+    int64_t cambiados = 0;
+    int64_t fin = inicio + cantidad;
+
+    while (inicio < fin)
+    {
+        int64_t idx = inicio / BITS_POR_PALABRA;
+        int desde = static_cast<int>(inicio % BITS_POR_PALABRA);
+        int hasta = static_cast<int>(std::min<int64_t>(BITS_POR_PALABRA, fin - idx * BITS_POR_PALABRA));
+        uint64_t mascara = mascara_rango(desde, hasta);
+
+        cambiados += __builtin_popcountll(mascara & palabras[idx]);
+        palabras[idx] &= ~mascara;
+        inicio = idx * BITS_POR_PALABRA + hasta;
+    }
+
+    return cambiados;
+}
+
+/*
+ * BUSCAR_LIBRES_CONSECUTIVOS
+ *
+ * Recorre palabra por palabra llevando la racha libre que viene de las
+ * palabras anteriores:
+ *
+ * - Palabra llena (todo ocupado): la racha se corta, siguiente palabra.
+ * - Palabra vacía (todo libre): la racha crece 64 de un solo paso.
+ * - Palabra mixta:
+ *   1. ctz(w)  = libres al inicio de la palabra → completan la racha previa
+ *   2. rachas internas: se busca una racha de `cantidad` ceros dentro de
+ *      la palabra plegando la máscara libre sobre sí misma (O(log n))
+ *   3. clz(w)  = libres al final de la palabra → nueva racha que sigue
+ *      en la próxima palabra
+ *
+ * Devuelve el mismo resultado que el recorrido bit a bit (primer ajuste).
+ */
+int64_t BitmapPalabras::buscar_libres_consecutivos(int64_t cantidad) const
+{
+    if (cantidad <= 0 || cantidad > num_bits)
+        return -1;
+
+    int64_t racha = 0;        // Libres consecutivos acumulados
+    int64_t inicio_racha = 0; // Dónde comenzó la racha actual
+
+    for (int64_t idx = 0; idx < num_palabras(); idx++)
+    {
+        uint64_t w = palabras[idx];
+        int64_t base = idx * BITS_POR_PALABRA;
+
+        if (w == PALABRA_LLENA)
+        {
+            racha = 0;
+            continue;
+        }
+
+        if (w == 0)
+        {
+            if (racha == 0)
+                inicio_racha = base;
+            racha += BITS_POR_PALABRA;
+            if (racha >= cantidad)
+                return inicio_racha;
+            continue;
+        }
+
+        // Paso 1: prefijo libre de la palabra
+        int prefijo = __builtin_ctzll(w);
+        if (racha == 0)
+            inicio_racha = base;
+        if (racha + prefijo >= cantidad)
+            return inicio_racha;
+
+        // Paso 2: racha completa dentro de la palabra
+        if (cantidad < BITS_POR_PALABRA)
+        {
+            uint64_t libres = ~w;
+            int64_t largo = 1;
+            while (largo < cantidad)
+            {
+                int64_t paso = std::min(largo, cantidad - largo);
+                libres &= libres >> paso;
+                largo += paso;
+            }
+            if (libres != 0)
+                return base + __builtin_ctzll(libres);
+        }
+
+        // Paso 3: sufijo libre que continúa en la siguiente palabra
+        racha = __builtin_clzll(w);
+        inicio_racha = base + BITS_POR_PALABRA - racha;
+    }
+
+    return -1;
+}
+
+ResumenRachas BitmapPalabras::resumen_rachas() const
+{
+    ResumenRachas resumen = analizar_rachas(palabras, num_palabras());
+    resumen.ocupados -= num_palabras() * BITS_POR_PALABRA - num_bits; // Relleno
+    return resumen;
+}
+
+/*
+ * RACHA_LIBRE_DESDE / RACHA_LIBRE_HASTA
+ *
+ * Miden una racha libre saltando palabras vacías de a 64 y cortando en
+ * el primer bit ocupado con ctz (hacia adelante) o clz (hacia atrás).
+ */
+int64_t BitmapPalabras::racha_libre_desde(int64_t pos) const
+{
+    int64_t largo = 0;
+
+    while (pos < num_bits)
+    {
+        int64_t idx = pos / BITS_POR_PALABRA;
+        int bit = static_cast<int>(pos % BITS_POR_PALABRA);
+        uint64_t ocupados = palabras[idx] >> bit;
+
+        if (ocupados != 0)
+            return largo + __builtin_ctzll(ocupados);
+
+        largo += BITS_POR_PALABRA - bit;
+        pos += BITS_POR_PALABRA - bit;
+    }
+
+    // El relleno está ocupado, así que solo se llega aquí con pos == num_bits
+    return largo;
+}
+
+int64_t BitmapPalabras::racha_libre_hasta(int64_t pos) const
+{
+    int64_t largo = 0;
+
+    while (pos > 0)
+    {
+        int64_t idx = (pos - 1) / BITS_POR_PALABRA;
+        int bits = static_cast<int>(pos - idx * BITS_POR_PALABRA); // Bits [0, bits) de la palabra
+        uint64_t ocupados = palabras[idx] & mascara_rango(0, bits);
+
+        if (ocupados != 0)
+            return largo + (bits - (BITS_POR_PALABRA - __builtin_clzll(ocupados)));
+
+        largo += bits;
+        pos -= bits;
+    }
+
+    return largo;
+}
@@ -0,0 +1,160 @@
+/*
+ * bitmap_palabras.h
+ *
+ * Mapa de bits empaquetado en palabras de 64 bits (`uint64_t`).
+ * Reemplaza a `std::vector<bool>` en los recorridos críticos: permite
+ * saltar palabras completas en un paso, buscar rachas libres con
+ * ctz/clz y marcar/limpiar rangos con máscaras.
+ *
+ * CONVENCIÓN:
+ * bit = 1 → bloque ocupado
+ * bit = 0 → bloque libre
+ * Los bits de relleno de la última palabra se mantienen en 1 para que
+ * ninguna búsqueda los devuelva como libres.
+ *
+ * ALMACENAMIENTO:
+ * Normalmente las palabras son propias (un std::vector). Con adoptar()
+ * pasan a ser memoria ajena, por ejemplo un archivo mapeado con mmap:
+ * no se copia nada, y `dueno` libera esa memoria cuando el bitmap deja
+ * de usarla. Copiar un bitmap siempre produce palabras propias.
+ */
+
+#ifndef BITMAP_PALABRAS_H
+#define BITMAP_PALABRAS_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include "kernel_rachas.h"
+
+class BitmapPalabras
+{
+private:
+    uint64_t *palabras;             // Bits agrupados de 64 en 64
+    int64_t cantidad_palabras;
+    int64_t num_bits;               // Bits válidos (sin relleno)
+
+    std::vector<uint64_t> propias;  // Almacenamiento propio (si no es externo)
+    std::shared_ptr<void> externo;  // Dueño de la memoria adoptada
+
+    // Máscara con los bits [desde, hasta) de una palabra encendidos
+    static uint64_t mascara_rango(int desde, int hasta);
+
+    // Enciende los bits de relleno de la última palabra
+    void sellar_relleno();
+
+public:
+    static const int BITS_POR_PALABRA = 64;
+
+    explicit BitmapPalabras(int64_t num_bits = 0);
+    BitmapPalabras(const BitmapPalabras &otro);
+    BitmapPalabras(BitmapPalabras &&otro) noexcept;
+    BitmapPalabras &operator=(const BitmapPalabras &otro);
+    BitmapPalabras &operator=(BitmapPalabras &&otro) noexcept;
+
+    // Cambiar el tamaño; todos los bits quedan libres (almacenamiento propio)
+    void redimensionar(int64_t nuevos_bits);
+
+    // Usar `datos` (ceil(nuevos_bits / 64) palabras) sin copiarlas; el
+    // relleno se vuelve a sellar. `dueno` mantiene viva esa memoria.
+    void adoptar(uint64_t *datos, int64_t nuevos_bits, std::shared_ptr<void> dueno);
+    bool es_externo() const { return externo != nullptr; }
+
+    int64_t tamanio() const { return num_bits; }
+    int64_t num_palabras() const { return cantidad_palabras; }
+    const uint64_t *datos() const { return palabras; }
+
+    // Acceso a un bit individual
+    bool operator[](int64_t i) const
+    {
+        return (palabras[i / BITS_POR_PALABRA] >> (i % BITS_POR_PALABRA)) & 1ULL;
+    }
+    void asignar(int64_t i, bool ocupado);
+
+    // Marcar [inicio, inicio+cantidad) como ocupado
+    // Retorna: cuántos bits pasaron de libre a ocupado
+    int64_t marcar_rango(int64_t inicio, int64_t cantidad);
+
+    // Marcar [inicio, inicio+cantidad) como libre
+    // Retorna: cuántos bits pasaron de ocupado a libre
+    int64_t limpiar_rango(int64_t inicio, int64_t cantidad);
+
+    // Primer ajuste: inicio de la primera racha de `cantidad` bits libres
+    // Retorna: posición de inicio, o -1 si no existe
+    int64_t buscar_libres_consecutivos(int64_t cantidad) const;
+
+    // Ocupados y racha libre más larga en una sola pasada (kernel SIMD)
+    // Los bits de relleno no se cuentan como ocupados.
+    ResumenRachas resumen_rachas() const;
+
+    // Largo de la racha libre que empieza en `pos` (hacia adelante)
+    int64_t racha_libre_desde(int64_t pos) const;
+
+    // Largo de la racha libre que termina justo antes de `pos` (hacia atrás)
+    int64_t racha_libre_hasta(int64_t pos) const;
+
+    // Llamar a f(inicio, tamanio) por cada racha libre dentro de
+    // [desde, hasta), recortada a ese rango. Trabaja por palabras: las
+    // palabras llenas se saltan y las rachas se extraen con ctz.
+    template <typename F>
+    void recorrer_rachas_libres(int64_t desde, int64_t hasta, F &&f) const;
+};
+
+template <typename F>
+void BitmapPalabras::recorrer_rachas_libres(int64_t desde, int64_t hasta, F &&f) const
+{
+    int64_t inicio_abierto = -1; // Racha que sigue en la próxima palabra
+
+    for (int64_t pos = desde; pos < hasta;)
+    {
+        int64_t idx = pos / BITS_POR_PALABRA;
+        int64_t base = idx * BITS_POR_PALABRA;
+        int bit_desde = static_cast<int>(pos - base);
+        int bit_hasta = static_cast<int>(std::min<int64_t>(BITS_POR_PALABRA, hasta - base));
+
+        // Bits libres de esta palabra dentro del rango
+        uint64_t libres = ~palabras[idx] & mascara_rango(bit_desde, bit_hasta);
+
+        if (libres == 0 && inicio_abierto != -1)
+        {
+            f(inicio_abierto, pos - inicio_abierto);
+            inicio_abierto = -1;
+        }
+
+        while (libres != 0)
+        {
+            int bit = __builtin_ctzll(libres);
+            uint64_t resto = ~(libres >> bit); // Ceros donde termina la racha
+            int largo = resto != 0 ? __builtin_ctzll(resto) : BITS_POR_PALABRA;
+
+            int64_t inicio = base + bit;
+            if (inicio_abierto != -1)
+            {
+                if (bit == 0)
+                    inicio = inicio_abierto; // Continúa la racha anterior
+                else
+                    f(inicio_abierto, base - inicio_abierto);
+                inicio_abierto = -1;
+            }
+
+            if (bit + largo == bit_hasta && bit_hasta == BITS_POR_PALABRA)
+            {
+                inicio_abierto = inicio; // Llega al final de la palabra
+                break;
+            }
+
+            f(inicio, base + bit + largo - inicio);
+            libres &= ~mascara_rango(bit, bit + largo);
+        }
+
+        pos = base + bit_hasta;
+    }
+
+    if (inicio_abierto != -1)
+    {
+        f(inicio_abierto, hasta - inicio_abierto);
+    }
+}
+
+#endif // BITMAP_PALABRAS_H
@@ -0,0 +1,223 @@
+/*
+ * cola_peticiones.cpp
+ *
+ * Implementación de la cola con planificador de ascensor.
+ */
+
+#include "cola_peticiones.h"
+#include <iterator>
+#include <limits>
+
+const char *nombre_politica(PoliticaCola politica)
+{
+    switch (politica)
+    {
+    case FIFO:
+        return "FIFO";
+    case SCAN:
+        return "SCAN";
+    case CLOOK:
+        return "C-LOOK";
+    }
+    return "?";
+}
+
+ColaPeticiones::ColaPeticiones(GestorDisco *gestor, PoliticaCola politica)
+    : gestor(gestor),
+      politica(politica),
+      siguiente_llegada(0),
+      en_servicio(false),
+      detener(false),
+      tapada(false),
+      subiendo(true),
+      cabezal(0),
+      reloj_us(gestor->get_tiempo_virtual_us()),
+      hilo(&ColaPeticiones::atender_peticiones, this)
+{
+}
+
+ColaPeticiones::~ColaPeticiones()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    hay_trabajo.notify_one();
+    hilo.join();
+}
+
+// encolar: sellar la llegada con el reloj virtual y despertar al hilo
+
+void ColaPeticiones::encolar(Peticion peticion, IndiceBloque posicion)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        peticion.llegada_us = reloj_us;
+        Clave clave = {politica == FIFO ? 0 : posicion, siguiente_llegada++};
+        pendientes.emplace(clave, std::move(peticion));
+    }
+    hay_trabajo.notify_one();
+}
+
+std::future<IndiceBloque> ColaPeticiones::encolar_allocacion(IndiceBloque num_bloques)
+{
+    Peticion peticion;
+    peticion.tipo = ALLOCACION;
+    peticion.inicio = -1;
+    peticion.num_bloques = num_bloques;
+    std::future<IndiceBloque> futuro = peticion.resultado_allocacion.get_future();
+
+    IndiceBloque posicion;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        posicion = cabezal;
+    }
+    encolar(std::move(peticion), posicion);
+    return futuro;
+}
+
+std::future<bool> ColaPeticiones::encolar_liberacion(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    Peticion peticion;
+    peticion.tipo = LIBERACION;
+    peticion.inicio = inicio;
+    peticion.num_bloques = num_bloques;
+    std::future<bool> futuro = peticion.resultado_liberacion.get_future();
+
+    encolar(std::move(peticion), inicio);
+    return futuro;
+}
+
+// ============================================================================
+// ELEGIR_SIGUIENTE (con el mutex tomado y `pendientes` no vacío)
+//
+// EJEMPLO: cabezal en 50, pendientes en 10, 40, 60, 90
+//   FIFO   → la que llegó primero
+//   SCAN   subiendo: 60, 90, (se da vuelta) 40, 10
+//   C-LOOK 60, 90, (vuelve abajo) 10, 40
+// ============================================================================
+
+std::map<ColaPeticiones::Clave, ColaPeticiones::Peticion>::iterator ColaPeticiones::elegir_siguiente()
+{
+    if (politica == FIFO)
+        return pendientes.begin();
+
+    auto arriba = pendientes.lower_bound({cabezal, 0});
+
+    if (politica == CLOOK)
+        return arriba != pendientes.end() ? arriba : pendientes.begin();
+
+    // SCAN
+    if (subiendo)
+    {
+        if (arriba != pendientes.end())
+            return arriba;
+        subiendo = false;
+    }
+
+    auto abajo = pendientes.upper_bound({cabezal, std::numeric_limits<uint64_t>::max()});
+    if (abajo != pendientes.begin())
+        return std::prev(abajo);
+
+    subiendo = true; // No queda nada abajo: todo está arriba
+    return arriba;
+}
+
+// ============================================================================
+// ATENDER_PETICIONES (hilo de servicio)
+//
+// 1. Esperar a que haya algo pendiente y la cola no esté tapada
+//    (al detener se atiende lo que quede aunque esté tapada)
+// 2. Elegir según la política y sacarla de la cola
+// 3. Sin el mutex: ejecutarla en el gestor
+// 4. Con el mutex: actualizar cabezal, reloj y métricas; cumplir la promesa
+// ============================================================================
+
+void ColaPeticiones::atender_peticiones()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        hay_trabajo.wait(lock, [this]
+                         { return detener || (!tapada && !pendientes.empty()); });
+        if (pendientes.empty())
+            return; // detener y no queda nada
+
+        auto it = elegir_siguiente();
+        estadisticas.profundidad_acumulada += pendientes.size();
+        if (pendientes.size() > estadisticas.profundidad_maxima)
+            estadisticas.profundidad_maxima = pendientes.size();
+
+        Peticion peticion = std::move(it->second);
+        pendientes.erase(it);
+        en_servicio = true;
+        lock.unlock();
+
+        double comienzo_us = gestor->get_tiempo_virtual_us();
+        IndiceBloque inicio = -1;
+        bool exito = false;
+        IndiceBloque ultimo_bloque = -1;
+
+        if (peticion.tipo == ALLOCACION)
+        {
+            inicio = gestor->allocar(peticion.num_bloques);
+            if (inicio != -1)
+                ultimo_bloque = inicio + peticion.num_bloques - 1;
+        }
+        else
+        {
+            exito = gestor->liberar(peticion.inicio, peticion.num_bloques);
+            ultimo_bloque = peticion.inicio + peticion.num_bloques - 1;
+        }
+
+        double fin_us = gestor->get_tiempo_virtual_us();
+
+        lock.lock();
+        if (ultimo_bloque >= 0)
+            cabezal = ultimo_bloque;
+        reloj_us = fin_us;
+        estadisticas.atendidas++;
+        estadisticas.espera_total_us += comienzo_us - peticion.llegada_us;
+        estadisticas.servicio_total_us += fin_us - comienzo_us;
+        en_servicio = false;
+
+        // Cumplir la promesa recién ahora: quien la espera ya ve el
+        // cabezal y el reloj actualizados
+        if (peticion.tipo == ALLOCACION)
+            peticion.resultado_allocacion.set_value(inicio);
+        else
+            peticion.resultado_liberacion.set_value(exito);
+
+        if (pendientes.empty())
+            vacia.notify_all();
+    }
+}
+
+void ColaPeticiones::tapar()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    tapada = true;
+}
+
+void ColaPeticiones::destapar()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tapada = false;
+    }
+    hay_trabajo.notify_one();
+}
+
+void ColaPeticiones::esperar_vacia()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    vacia.wait(lock, [this]
+               { return pendientes.empty() && !en_servicio; });
+}
+
+EstadisticasCola ColaPeticiones::get_estadisticas()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return estadisticas;
+}
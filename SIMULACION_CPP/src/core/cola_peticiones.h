@@ -0,0 +1,128 @@
+/*
+ * cola_peticiones.h
+ *
+ * Cola de peticiones asíncrona delante de un `GestorDisco`.
+ *
+ * CÓMO FUNCIONA:
+ * Los clientes encolan allocaciones y liberaciones y reciben un
+ * std::future con el resultado. Un hilo de servicio toma las peticiones
+ * pendientes y las atiende en el orden que decida la política:
+ *
+ *  FIFO   orden de llegada (lo que pasa sin cola)
+ *  SCAN   ascensor: sigue en la dirección actual y se da vuelta en la
+ *         última petición (variante LOOK, como los planificadores de Linux)
+ *  CLOOK  solo hacia arriba; al llegar al final vuelve a la más baja
+ *
+ * Cada petición se ordena por su posición en el disco: una liberación
+ * por su bloque de inicio; una allocación, que todavía no tiene lugar,
+ * por la posición del cabezal al momento de encolarla.
+ *
+ * TIEMPOS:
+ * Todo se mide en el reloj VIRTUAL del gestor (ver ModeloDispositivo):
+ * - espera:   desde que llega hasta que empieza a atenderse
+ * - servicio: lo que cobra el dispositivo por atenderla
+ *
+ * TAPAR / DESTAPAR (como el "plugging" del block layer de Linux):
+ * mientras la cola está tapada el hilo no despacha; así un lote
+ * encolado de golpe se ve completo antes de ordenarlo.
+ *
+ * RESTRICCIÓN:
+ * Mientras la cola existe, solo su hilo toca el gestor.
+ */
+
+#ifndef COLA_PETICIONES_H
+#define COLA_PETICIONES_H
+
+#include "disk_manager.h"
+#include <map>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+
+enum PoliticaCola
+{
+    FIFO,
+    SCAN,
+    CLOOK
+};
+
+const char *nombre_politica(PoliticaCola politica);
+
+// Métricas acumuladas de la cola (tiempos en µs del reloj virtual)
+struct EstadisticasCola
+{
+    long long atendidas = 0;
+    double espera_total_us = 0.0;
+    double servicio_total_us = 0.0;
+    double profundidad_acumulada = 0.0; // Suma de la profundidad vista en cada despacho
+    size_t profundidad_maxima = 0;
+
+    double espera_media_us() const { return atendidas ? espera_total_us / atendidas : 0.0; }
+    double servicio_medio_us() const { return atendidas ? servicio_total_us / atendidas : 0.0; }
+    double profundidad_media() const { return atendidas ? profundidad_acumulada / atendidas : 0.0; }
+};
+
+class ColaPeticiones
+{
+private:
+    struct Peticion
+    {
+        TipoOperacion tipo;
+        IndiceBloque inicio; // Solo liberaciones
+        IndiceBloque num_bloques;
+        double llegada_us;
+        std::promise<IndiceBloque> resultado_allocacion;
+        std::promise<bool> resultado_liberacion;
+    };
+
+    // Clave: {posición, número de llegada}. En FIFO la posición es 0 para
+    // todas, así que el orden del mapa es el de llegada.
+    typedef std::pair<IndiceBloque, uint64_t> Clave;
+
+    GestorDisco *gestor;
+    PoliticaCola politica;
+
+    std::mutex mutex;
+    std::condition_variable hay_trabajo;
+    std::condition_variable vacia;
+    std::map<Clave, Peticion> pendientes;
+    uint64_t siguiente_llegada;
+    bool en_servicio;   // El hilo está atendiendo una petición
+    bool detener;
+    bool tapada;        // No despachar hasta destapar()
+    bool subiendo;      // Dirección del ascensor (SCAN)
+    IndiceBloque cabezal; // Último bloque atendido
+    double reloj_us;    // Copia del reloj virtual al terminar la última petición
+    EstadisticasCola estadisticas;
+
+    std::thread hilo; // Último miembro: arranca con todo lo demás inicializado
+
+    void encolar(Peticion peticion, IndiceBloque posicion);
+    std::map<Clave, Peticion>::iterator elegir_siguiente();
+    void atender_peticiones();
+
+public:
+    ColaPeticiones(GestorDisco *gestor, PoliticaCola politica = CLOOK);
+    ~ColaPeticiones(); // Atiende lo pendiente y detiene el hilo
+
+    ColaPeticiones(const ColaPeticiones &) = delete;
+    ColaPeticiones &operator=(const ColaPeticiones &) = delete;
+
+    // Resultado: igual que GestorDisco::allocar / liberar
+    std::future<IndiceBloque> encolar_allocacion(IndiceBloque num_bloques);
+    std::future<bool> encolar_liberacion(IndiceBloque inicio, IndiceBloque num_bloques);
+
+    // Retener / soltar el despacho (ver TAPAR / DESTAPAR arriba)
+    void tapar();
+    void destapar();
+
+    // Bloquear hasta que no quede nada pendiente ni en servicio
+    // (la cola debe estar destapada)
+    void esperar_vacia();
+
+    EstadisticasCola get_estadisticas();
+};
+
+#endif // COLA_PETICIONES_H
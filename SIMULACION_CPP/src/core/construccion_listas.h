@@ -0,0 +1,172 @@
+/*
+ * construccion_listas.h
+ *
+ * Construcción en bloque de una lista de huecos ordenada por posición a
+ * partir del bitmap del disco, repartida entre varios hilos. La usan
+ * ListaSimple y ListaDoble en reconstruir().
+ *
+ * CÓMO FUNCIONA:
+ * 1. Las palabras del disco se parten en tramos contiguos, uno por hilo
+ * 2. Cada hilo saca las rachas libres de su tramo por palabras
+ *    (recorrer_rachas_libres) y arma su sublista enganchando al final,
+ *    con su propia arena de nodos y su propio histograma de tamaños
+ * 3. Un solo hilo cose los tramos en orden. Si una racha cruza el borde
+ *    (la última de un tramo termina donde empieza la primera del
+ *    siguiente), los dos nodos se unen en uno:
+ *
+ *    tramo 0: [0-3] → [9-15]      tramo 1: [16-20] → [30-31]
+ *                        └─── se tocan ───┘
+ *    lista:   [0-3] → [9-20] → [30-31]
+ *
+ * 4. Las arenas de los hilos pasan a la de la lista (PoolNodos::absorber)
+ *
+ * COMPLEJIDAD: O((palabras + huecos) / hilos + hilos + tamaños distintos)
+ * Nunca se recorre la lista para insertar: los huecos ya llegan ordenados.
+ */
+
+#ifndef CONSTRUCCION_LISTAS_H
+#define CONSTRUCCION_LISTAS_H
+
+#include "bitmap_palabras.h"
+#include "pool_nodos.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <thread>
+#include <vector>
+
+// Menos palabras que esto por hilo (2^15 palabras = 2M bloques) no
+// compensa lanzarlo: el tramo se arma más rápido de lo que tarda en
+// arrancar el hilo
+const int64_t PALABRAS_MINIMAS_POR_TRAMO = int64_t(1) << 15;
+
+// Los tamaños de hueco menores a esto se cuentan en un arreglo por hilo
+// (un disco fragmentado casi no tiene otros); el resto, en un map
+const int64_t HUECOS_CHICOS = 256;
+
+// Un hilo por núcleo, pero sin tramos más chicos que el mínimo
+inline size_t tramos_construccion(int64_t palabras)
+{
+    size_t nucleos = std::max(1u, std::thread::hardware_concurrency());
+    int64_t por_tamanio = std::max<int64_t>(1, palabras / PALABRAS_MINIMAS_POR_TRAMO);
+    return static_cast<size_t>(std::min<int64_t>(por_tamanio, static_cast<int64_t>(nucleos)));
+}
+
+// Armar la lista de huecos libres de `disco` en `pool` (que se vacía
+// antes) y dejar en `histograma` cuántos huecos hay de cada tamaño.
+// `enlazar(a, b)` pone b después de a (la lista doble también fija el
+// anterior). Retorna el primer nodo (nullptr si no hay huecos) y deja el
+// último en `ultimo`.
+template <typename Nodo, typename Enlazar>
+Nodo *construir_lista_en_bloque(const BitmapPalabras &disco, int64_t total_bloques,
+                                PoolNodos<Nodo> &pool, std::map<int64_t, int64_t> &histograma,
+                                Nodo *&ultimo, Enlazar enlazar)
+{
+    struct Tramo
+    {
+        PoolNodos<Nodo> arena; // El tramo 0 usa directamente `pool`
+        Nodo *primero = nullptr;
+        Nodo *ultimo = nullptr;
+        std::vector<int64_t> chicos = std::vector<int64_t>(HUECOS_CHICOS, 0);
+        std::map<int64_t, int64_t> grandes;
+    };
+
+    int64_t palabras = disco.num_palabras();
+    size_t cantidad = tramos_construccion(palabras);
+    std::vector<Tramo> tramos(cantidad);
+
+    // Con un solo tramo se reaprovechan las losas; con varios se sueltan,
+    // si no crecerían en cada reconstrucción (absorber solo agrega)
+    if (cantidad == 1)
+        pool.reiniciar();
+    else
+        pool.vaciar();
+
+    auto armar = [&](size_t k)
+    {
+        Tramo &tramo = tramos[k];
+        PoolNodos<Nodo> &arena = (k == 0) ? pool : tramo.arena;
+        int64_t desde = static_cast<int64_t>(palabras * k / cantidad) * BitmapPalabras::BITS_POR_PALABRA;
+        int64_t hasta = std::min(total_bloques,
+                                 static_cast<int64_t>(palabras * (k + 1) / cantidad) * BitmapPalabras::BITS_POR_PALABRA);
+
+        auto enganchar = [&](int64_t inicio, int64_t tamanio)
+        {
+            Nodo *nuevo = arena.crear(inicio, tamanio);
+            if (tramo.ultimo == nullptr)
+                tramo.primero = nuevo;
+            else
+                enlazar(tramo.ultimo, nuevo);
+            tramo.ultimo = nuevo;
+
+            if (tamanio < HUECOS_CHICOS)
+                tramo.chicos[tamanio]++;
+            else
+                tramo.grandes[tamanio]++;
+        };
+        disco.recorrer_rachas_libres(desde, hasta, enganchar);
+    };
+
+    std::vector<std::thread> hilos;
+    for (size_t k = 1; k < cantidad; k++)
+        hilos.emplace_back(armar, k);
+    armar(0);
+    for (std::thread &hilo : hilos)
+        hilo.join();
+
+    // Juntar arenas e histogramas
+    histograma.clear();
+    for (size_t k = 0; k < cantidad; k++)
+    {
+        if (k > 0)
+            pool.absorber(tramos[k].arena);
+        for (int64_t tamanio = 1; tamanio < HUECOS_CHICOS; tamanio++)
+        {
+            if (tramos[k].chicos[tamanio] > 0)
+                histograma[tamanio] += tramos[k].chicos[tamanio];
+        }
+        for (const auto &par : tramos[k].grandes)
+            histograma[par.first] += par.second;
+    }
+
+    auto retirar = [&](int64_t tamanio)
+    {
+        auto it = histograma.find(tamanio);
+        if (--it->second == 0)
+            histograma.erase(it);
+    };
+
+    // Coser los tramos en orden, uniendo las rachas que cruzan un borde
+    Nodo *primero = nullptr;
+    ultimo = nullptr;
+    for (Tramo &tramo : tramos)
+    {
+        Nodo *resto = tramo.primero;
+        if (resto == nullptr)
+            continue;
+
+        if (ultimo != nullptr && ultimo->inicio + ultimo->tamanio == resto->inicio)
+        {
+            retirar(ultimo->tamanio);
+            retirar(resto->tamanio);
+            ultimo->tamanio += resto->tamanio;
+            histograma[ultimo->tamanio]++;
+
+            Nodo *unido = resto;
+            resto = (unido == tramo.ultimo) ? nullptr : unido->siguiente;
+            pool.destruir(unido);
+            if (resto == nullptr)
+                continue; // Tramo entero libre: la racha sigue en el próximo
+        }
+
+        if (ultimo == nullptr)
+            primero = resto;
+        else
+            enlazar(ultimo, resto);
+        ultimo = tramo.ultimo;
+    }
+
+    return primero;
+}
+
+#endif // CONSTRUCCION_LISTAS_H
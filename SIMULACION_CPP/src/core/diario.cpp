@@ -0,0 +1,351 @@
+/*
+ * diario.cpp
+ *
+ * Diario de escritura anticipada con commit en grupo (ver diario.h).
+ * Las escrituras van con write/fdatasync de POSIX: hace falta saber
+ * cuándo los bytes llegaron al dispositivo, no solo al buffer de la
+ * biblioteca.
+ */
+
+#include "diario.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char MAGIA_DIARIO[4] = {'D', 'I', 'A', 'R'};
+static const uint32_t VERSION_DIARIO = 1;
+
+struct CabeceraDiario
+{
+    char magia[4];
+    uint32_t version;
+    int64_t total_bloques;
+};
+static_assert(sizeof(CabeceraDiario) == 16, "cabecera del diario de 16 bytes");
+
+// FNV-1a de 32 bits sobre todo el registro menos la propia suma
+
+static uint32_t suma_registro(const RegistroDiario &registro)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&registro);
+    uint32_t suma = 2166136261u;
+    for (size_t i = 0; i < offsetof(RegistroDiario, suma); i++)
+    {
+        suma ^= bytes[i];
+        suma *= 16777619u;
+    }
+    return suma;
+}
+
+// write() hasta escribir todo (puede escribir menos de lo pedido)
+
+static bool escribir_todo(int fd, const void *datos, size_t largo)
+{
+    const char *p = static_cast<const char *>(datos);
+    while (largo > 0)
+    {
+        ssize_t escritos = write(fd, p, largo);
+        if (escritos < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        p += escritos;
+        largo -= static_cast<size_t>(escritos);
+    }
+    return true;
+}
+
+// El rename de un archivo es durable recién cuando se sincroniza el
+// directorio que lo contiene
+
+static void sincronizar_directorio(const std::string &ruta)
+{
+    size_t barra = ruta.find_last_of('/');
+    std::string directorio = (barra == std::string::npos) ? "." : ruta.substr(0, barra);
+    int fd = open(directorio.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+// ============================================================================
+// LECTURA
+// ============================================================================
+
+// Lee la cabecera y los registros válidos; `bytes_validos` queda en el
+// final del último registro sano (para recortar lo que siga)
+
+static bool leer_registros(int fd, IndiceBloque &total_bloques, std::vector<RegistroDiario> &registros,
+                           off_t &bytes_validos)
+{
+    CabeceraDiario cabecera;
+    if (pread(fd, &cabecera, sizeof(cabecera), 0) != static_cast<ssize_t>(sizeof(cabecera)) ||
+        std::memcmp(cabecera.magia, MAGIA_DIARIO, sizeof(cabecera.magia)) != 0 ||
+        cabecera.version != VERSION_DIARIO)
+    {
+        return false;
+    }
+    total_bloques = cabecera.total_bloques;
+
+    registros.clear();
+    bytes_validos = sizeof(CabeceraDiario);
+    uint64_t secuencia_anterior = 0;
+
+    // De a muchos registros por lectura
+    std::vector<RegistroDiario> bloque(4096);
+    while (true)
+    {
+        ssize_t leidos = pread(fd, bloque.data(), bloque.size() * sizeof(RegistroDiario), bytes_validos);
+        size_t completos = leidos > 0 ? static_cast<size_t>(leidos) / sizeof(RegistroDiario) : 0;
+
+        for (size_t i = 0; i < completos; i++)
+        {
+            const RegistroDiario &registro = bloque[i];
+            bool sano = registro.suma == suma_registro(registro) &&
+                        registro.secuencia > secuencia_anterior &&
+                        (registro.tipo == DIARIO_ALLOCAR || registro.tipo == DIARIO_LIBERAR);
+            if (!sano)
+                return true; // Final cortado: lo que sigue no cuenta
+
+            registros.push_back(registro);
+            secuencia_anterior = registro.secuencia;
+            bytes_validos += sizeof(RegistroDiario);
+        }
+
+        if (completos < bloque.size())
+            return true; // Fin del archivo (quizá con medio registro)
+    }
+}
+
+bool leer_diario(const std::string &ruta, IndiceBloque &total_bloques, std::vector<RegistroDiario> &registros)
+{
+    int fd = open(ruta.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Error al abrir el diario: " << ruta << "\n";
+        return false;
+    }
+
+    off_t bytes_validos = 0;
+    bool ok = leer_registros(fd, total_bloques, registros, bytes_validos);
+    close(fd);
+
+    if (!ok)
+        std::cerr << "Diario inválido (cabecera): " << ruta << "\n";
+    return ok;
+}
+
+// ============================================================================
+// ESCRITURA
+// ============================================================================
+
+Diario::Diario(const std::string &ruta, IndiceBloque total_bloques, bool en_grupo)
+    : fd(-1), ruta(ruta), en_grupo(en_grupo),
+      ultima_secuencia(0), secuencia_durable(0),
+      error_escritura(false), detener(false),
+      sincronizaciones(0), registros_escritos(0)
+{
+    int abierto = open(ruta.c_str(), O_RDWR | O_CREAT, 0644);
+    if (abierto < 0)
+    {
+        std::cerr << "Error al abrir el diario: " << ruta << "\n";
+        return;
+    }
+
+    struct stat info;
+    if (fstat(abierto, &info) == 0 && info.st_size > 0)
+    {
+        // Diario existente: seguir después del último registro sano
+        IndiceBloque bloques_diario = 0;
+        std::vector<RegistroDiario> registros;
+        off_t bytes_validos = 0;
+        if (!leer_registros(abierto, bloques_diario, registros, bytes_validos) ||
+            bloques_diario != total_bloques)
+        {
+            std::cerr << "Diario inválido o de otro disco: " << ruta << "\n";
+            close(abierto);
+            return;
+        }
+        if (bytes_validos < info.st_size && ftruncate(abierto, bytes_validos) != 0)
+        {
+            std::cerr << "No se pudo recortar el final del diario: " << ruta << "\n";
+            close(abierto);
+            return;
+        }
+        if (!registros.empty())
+            ultima_secuencia = secuencia_durable = registros.back().secuencia;
+    }
+    else
+    {
+        CabeceraDiario cabecera;
+        std::memcpy(cabecera.magia, MAGIA_DIARIO, sizeof(cabecera.magia));
+        cabecera.version = VERSION_DIARIO;
+        cabecera.total_bloques = total_bloques;
+        if (!escribir_todo(abierto, &cabecera, sizeof(cabecera)) || fdatasync(abierto) != 0)
+        {
+            std::cerr << "Error al escribir el diario: " << ruta << "\n";
+            close(abierto);
+            return;
+        }
+        sincronizar_directorio(ruta);
+    }
+
+    lseek(abierto, 0, SEEK_END);
+    fd = abierto;
+    escritor = std::thread(&Diario::escribir_lotes, this);
+}
+
+Diario::~Diario()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    hay_pendientes.notify_one();
+    if (escritor.joinable())
+        escritor.join();
+    if (fd >= 0)
+        close(fd);
+}
+
+uint64_t Diario::agregar(TipoRegistroDiario tipo, IndiceBloque inicio, IndiceBloque tamanio)
+{
+    RegistroDiario registro;
+    std::memset(&registro, 0, sizeof(registro));
+    registro.inicio = inicio;
+    registro.tamanio = tamanio;
+    registro.tipo = tipo;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        registro.secuencia = ++ultima_secuencia;
+        registro.suma = suma_registro(registro);
+        pendientes.push_back(registro);
+    }
+    hay_pendientes.notify_one();
+    return registro.secuencia;
+}
+
+bool Diario::esperar(uint64_t secuencia)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    hay_durables.wait(lock, [&]
+                      { return secuencia_durable >= secuencia || error_escritura || fd < 0; });
+    return secuencia_durable >= secuencia && !error_escritura;
+}
+
+// ============================================================================
+// ESCRIBIR_LOTES (hilo escritor)
+//
+// Toma lo pendiente (todo, o de a uno sin commit en grupo), lo escribe
+// fuera del lock con un solo write + fdatasync y despierta a todos los
+// que esperaban algún registro de ese lote. Sale cuando se pide detener
+// y no queda nada pendiente.
+// ============================================================================
+
+void Diario::escribir_lotes()
+{
+    std::vector<RegistroDiario> lote;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        hay_pendientes.wait(lock, [this]
+                            { return detener || !pendientes.empty(); });
+        if (pendientes.empty())
+            return;
+
+        size_t cantidad = en_grupo ? pendientes.size() : 1;
+        lote.assign(pendientes.begin(), pendientes.begin() + cantidad);
+        pendientes.erase(pendientes.begin(), pendientes.begin() + cantidad);
+        lock.unlock();
+
+        bool ok = escribir_todo(fd, lote.data(), lote.size() * sizeof(RegistroDiario)) &&
+                  fdatasync(fd) == 0;
+
+        lock.lock();
+        sincronizaciones++;
+        if (ok)
+        {
+            registros_escritos += static_cast<long long>(lote.size());
+            secuencia_durable = lote.back().secuencia;
+        }
+        else
+        {
+            error_escritura = true;
+        }
+        hay_durables.notify_all();
+    }
+}
+
+// ============================================================================
+// PUNTO_DE_CONTROL
+//
+// 1. Esperar a que todo lo agregado hasta ahora (`hasta`) esté en disco
+// 2. guardar_estado: "<archivo>.tmp", fsync, rename sobre <archivo> (un
+//    corte a mitad deja el punto de control anterior intacto)
+// 3. Recortar el diario a su cabecera, SOLO si no se agregó nada después
+//    de `hasta`
+//
+// Un corte entre 2 y 3, o un registro agregado en el medio, deja un
+// punto de control nuevo con el diario viejo: al recuperar se repiten
+// registros ya incluidos, que no cambian nada (ver diario.h).
+// ============================================================================
+
+bool Diario::punto_de_control(const GestorDisco &gestor, const std::string &archivo_estado)
+{
+    if (fd < 0)
+        return false;
+
+    uint64_t hasta;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hasta = ultima_secuencia;
+    }
+    if (!esperar(hasta))
+        return false;
+
+    // guardar_estado escribe a un temporal, lo fuerza a disco y lo renombra
+    // encima: si falla, el punto de control anterior sigue entero y el
+    // diario, que lo completa, no se toca
+    if (!gestor.guardar_estado(archivo_estado))
+    {
+        std::cerr << "No se pudo guardar el punto de control: " << archivo_estado << "\n";
+        return false;
+    }
+    sincronizar_directorio(archivo_estado);
+
+    // Un registro agregado después de `hasta` puede no estar en la foto
+    // (y ya puede estar confirmado): el diario se deja como está. Volver a
+    // aplicarlo sobre el punto de control nuevo no cambia nada
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ultima_secuencia != hasta)
+        return true;
+    if (ftruncate(fd, sizeof(CabeceraDiario)) != 0 || fdatasync(fd) != 0)
+    {
+        std::cerr << "No se pudo vaciar el diario: " << ruta << "\n";
+        return false;
+    }
+    lseek(fd, 0, SEEK_END);
+    return true;
+}
+
+long long Diario::get_sincronizaciones()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return sincronizaciones;
+}
+
+long long Diario::get_registros_escritos()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return registros_escritos;
+}
@@ -0,0 +1,136 @@
+/*
+ * diario.h
+ *
+ * Diario de escritura anticipada (write-ahead log) de los metadatos de
+ * allocación, con commit en grupo.
+ *
+ * IDEA:
+ * Sin diario, el estado solo llega al archivo con guardar_estado(): un
+ * corte pierde todo lo hecho desde entonces. Con diario, cada allocar /
+ * liberar deja un registro {secuencia, tipo, inicio, tamaño} que se
+ * escribe y se fuerza a disco (fdatasync) ANTES de darle la operación
+ * por confirmada a quien la pidió.
+ *
+ * COMMIT EN GRUPO:
+ * Un fdatasync cuesta casi lo mismo con 1 registro que con 1000. Los
+ * hilos solo agregan su registro a un buffer en memoria y esperan; un
+ * hilo escritor toma TODO lo acumulado, lo escribe y hace un único
+ * fdatasync. Mientras ese fdatasync dura se va juntando el lote siguiente:
+ *
+ *  clientes:  r1 r2 r3 ............ r4 r5 r6 r7 ..........
+ *  escritor:  [write+fsync r1..r3]  [write+fsync r4..r7]
+ *                        └ confirma r1..r3      └ confirma r4..r7
+ *
+ * Con `en_grupo = false` el escritor toma de a un registro (un fsync por
+ * operación), para comparar.
+ *
+ * FORMATO (orden de bytes de la máquina, como el estado binario):
+ *  Cabecera, 16 bytes:  "DIAR" | versión u32 | total_bloques i64
+ *  Registros, 32 bytes: secuencia u64 | inicio i64 | tamaño i64 |
+ *                       tipo u32 | suma u32 (FNV-1a de los 28 anteriores)
+ *  Un registro cortado o con la suma mal marca el final del diario (lo
+ *  que se estaba escribiendo al cortarse la luz); se descarta junto con
+ *  lo que siga.
+ *
+ * RECUPERACIÓN (GestorDisco::recuperar):
+ * Último punto de control + los registros del diario en orden, aplicados
+ * tal cual sobre los bits. Un registro dice "este rango queda ocupado /
+ * libre", así que repetirlo sobre un estado que ya lo incluye no cambia
+ * nada: si el corte llega entre guardar el punto de control y vaciar el
+ * diario, no se pierde ni se duplica ninguna operación.
+ */
+
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include "disk_manager.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum TipoRegistroDiario : uint32_t
+{
+    DIARIO_ALLOCAR = 1,
+    DIARIO_LIBERAR = 2
+};
+
+struct RegistroDiario
+{
+    uint64_t secuencia;
+    int64_t inicio;
+    int64_t tamanio;
+    uint32_t tipo;
+    uint32_t suma;
+};
+static_assert(sizeof(RegistroDiario) == 32, "registro del diario de 32 bytes");
+
+class Diario
+{
+private:
+    int fd;
+    std::string ruta;
+    bool en_grupo;
+
+    std::mutex mutex;
+    std::condition_variable hay_pendientes; // Despierta al escritor
+    std::condition_variable hay_durables;   // Despierta a los que esperan
+    std::deque<RegistroDiario> pendientes;
+    uint64_t ultima_secuencia;  // Última asignada
+    uint64_t secuencia_durable; // Todo registro <= esta ya está en disco
+    bool error_escritura;
+    bool detener;
+
+    long long sincronizaciones; // fdatasync hechos
+    long long registros_escritos;
+
+    std::thread escritor; // Último miembro: arranca con todo lo demás listo
+
+    void escribir_lotes();
+
+public:
+    // Abrir (o crear) el diario. Si ya existe se valida contra
+    // `total_bloques`, se recorta un final cortado y se sigue numerando
+    // desde el último registro válido.
+    Diario(const std::string &ruta, IndiceBloque total_bloques, bool en_grupo = true);
+    ~Diario(); // Escribe lo pendiente y une el escritor
+
+    Diario(const Diario &) = delete;
+    Diario &operator=(const Diario &) = delete;
+
+    bool abierto() const { return fd >= 0; }
+
+    // Agregar un registro al lote en curso, sin esperar. Llamarlo en el
+    // mismo orden en que se aplicaron las operaciones (dentro del lock
+    // del gestor): ese es el orden en que se reproducen.
+    // Retorna: su número de secuencia
+    uint64_t agregar(TipoRegistroDiario tipo, IndiceBloque inicio, IndiceBloque tamanio);
+
+    // Bloquear hasta que el registro `secuencia` esté en disco
+    // Retorna: false si alguna escritura o fdatasync falló
+    bool esperar(uint64_t secuencia);
+
+    // Guardar el estado de `gestor` en `archivo_estado` (a un temporal,
+    // fsync y rename: el punto de control anterior sigue valiendo hasta
+    // el último paso) y vaciar el diario.
+    // Quien llama debe tener tomado el lock del gestor durante TODA la
+    // llamada: la foto se saca sin sincronizar con otros hilos. Si aun
+    // así se agrega algún registro mientras tanto, el diario no se vacía
+    // (volver a aplicarlo al recuperar no cambia nada).
+    // Retorna: false si algo falló; el diario solo se vacía si el punto
+    // de control nuevo quedó entero en disco
+    bool punto_de_control(const GestorDisco &gestor, const std::string &archivo_estado);
+
+    long long get_sincronizaciones();
+    long long get_registros_escritos();
+};
+
+// Leer los registros válidos de un diario (se detiene en el primero
+// cortado o con la suma mal)
+// Retorna: false (con mensaje en cerr) si no se puede abrir o la cabecera no es de un diario
+bool leer_diario(const std::string &ruta, IndiceBloque &total_bloques, std::vector<RegistroDiario> &registros);
+
+#endif // DIARIO_H
@@ -11,22 +11,129 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <memory>
+#include "bitmap_palabras.h"
+#include "pool_nodos.h"
+
+// Índice/cantidad de bloques: 64 bits para volúmenes de más de 2^31 bloques
+typedef int64_t IndiceBloque;
+
+// Extensión de bloques: {inicio, tamaño}
+typedef std::pair<IndiceBloque, IndiceBloque> Extension;
+
+// Valores por defecto de la geometría del disco
+// (cada gestor recibe los suyos en el constructor)
+
+const IndiceBloque TOTAL_BLOQUES = 1024; // Tamaño del disco: 1024 bloques
+const int TAMANIO_BLOQUE = 1024;         // Cada bloque = 1KB
+const float OCUPACION_INICIAL = 0.70;    // 70% ocupado al inicio
+
+// Lotes más chicos que esto se atienden con el bucle de allocar(): armar
+// el índice temporal por tamaño no se amortiza
+const size_t LOTE_MINIMO_INDICE = 16;
+
+// Bytes fijos de un nodo de std::map / std::set además de su valor
+// (color + padre + dos hijos en libstdc++), para uso_memoria()
+const size_t SOBRECARGA_NODO_ARBOL = 32;
+
+// Enumeración: Formato del archivo de estado (guardar_estado)
+//   BINARIO  cabecera + las palabras del bitmap tal cual (8 bytes cada 64
+//            bloques); cargar_estado lo mapea con mmap, sin copiar, y
+//            guardar_estado lo reemplaza con rename (nunca en su lugar)
+//   TEXTO    un dígito por bloque, 64 por línea: para leerlo o exportarlo
+
+enum FormatoEstado
+{
+    BINARIO,
+    TEXTO
+};
 
-// Constantes del sistema
+// Enumeración: Tipos de operación (para cobrar tiempo de dispositivo)
 
-const int TOTAL_BLOQUES = 1024;       // Tamaño del disco: 1024 bloques
-const int TAMANIO_BLOQUE = 1024;      // Cada bloque = 1KB
-const float OCUPACION_INICIAL = 0.70; // 70% ocupado al inicio
+enum TipoOperacion
+{
+    ALLOCACION, // Escribir los bloques asignados
+    LIBERACION, // Marcar el rango como libre (toca su primer bloque)
+    BUSQUEDA    // Solo metadatos en memoria, sin posición en el disco
+};
 
-// Enumeración: Tipos de operación (para simular delays)
+// Clase abstracta: ModeloDispositivo
+// Decide cuánto tiempo VIRTUAL cuesta una operación. No duerme: el costo
+// se suma a un reloj simulado, así que las corridas terminan en
+// milisegundos y aun así reportan tiempos de dispositivo realistas.
 
-enum TipoOperacion
+class ModeloDispositivo
+{
+public:
+    virtual ~ModeloDispositivo() {}
+
+    // Costo en microsegundos de atender la operación si empieza en el
+    // instante `ahora_us` del reloj simulado. inicio = -1 → sin posición.
+    // Puede cambiar el estado interno (p. ej. la posición del cabezal).
+    virtual double atender(TipoOperacion tipo, IndiceBloque inicio,
+                           IndiceBloque num_bloques, double ahora_us) = 0;
+
+    virtual std::string nombre() const = 0;
+};
+
+// Clase: ModeloHDD
+// Disco rotacional: seek desde la pista actual del cabezal + espera de
+// rotación hasta el sector pedido + transferencia a la velocidad de la
+// pista. Ver modelo_dispositivo.cpp para los parámetros.
+
+class ModeloHDD : public ModeloDispositivo
+{
+private:
+    int tamanio_bloque;
+    IndiceBloque bloques_por_pista;
+    IndiceBloque pista_actual; // Posición del cabezal
+
+    double tiempo_seek_us(IndiceBloque distancia) const;
+
+public:
+    ModeloHDD(int tamanio_bloque = TAMANIO_BLOQUE);
+
+    double atender(TipoOperacion tipo, IndiceBloque inicio,
+                   IndiceBloque num_bloques, double ahora_us) override;
+    std::string nombre() const override { return "hdd"; }
+};
+
+// Clase: ModeloSSD
+// Sin partes móviles: latencia fija por comando + transferencia por ancho
+// de banda. La posición no importa.
+
+class ModeloSSD : public ModeloDispositivo
+{
+private:
+    int tamanio_bloque;
+
+public:
+    ModeloSSD(int tamanio_bloque = TAMANIO_BLOQUE) : tamanio_bloque(tamanio_bloque) {}
+
+    double atender(TipoOperacion tipo, IndiceBloque inicio,
+                   IndiceBloque num_bloques, double ahora_us) override;
+    std::string nombre() const override { return "ssd"; }
+};
+
+// Clase: ModeloNulo
+// Costo cero: solo se mide el tiempo de CPU de las estructuras.
+
+class ModeloNulo : public ModeloDispositivo
 {
-    ALLOCACION, // Llenar bloques (5ms por bloque)
-    LIBERACION, // Vaciar bloques (2ms por bloque)
-    BUSQUEDA    // Buscar huecos (1ms total)
+public:
+    double atender(TipoOperacion, IndiceBloque, IndiceBloque, double) override { return 0.0; }
+    std::string nombre() const override { return "nulo"; }
 };
 
+// Crear un modelo por nombre ("hdd", "ssd", "nulo")
+// Retorna: nullptr si el nombre no se reconoce
+std::unique_ptr<ModeloDispositivo> crear_modelo_dispositivo(const std::string &nombre,
+                                                            int tamanio_bloque = TAMANIO_BLOQUE);
+
 // Clase base abstracta: GestorDisco
 // Define la interfaz común para los gestores de disco.
 
@@ -35,22 +142,58 @@ class GestorDisco
 protected:
     // ATRIBUTOS PROTEGIDOS (accesibles por clases hijas)
 
-    std::vector<bool> disco; // Estado REAL del disco
-                             // disco[i] = true → bloque i ocupado
-                             // disco[i] = false → bloque i libre
+    BitmapPalabras disco; // Estado REAL del disco
+                          // disco[i] = true → bloque i ocupado
+                          // disco[i] = false → bloque i libre
+
+    IndiceBloque total_bloques; // Geometría: número de bloques del disco
+    int tamanio_bloque;         // Geometría: bytes por bloque
+
+    IndiceBloque bloques_libres;   // Contador de bloques libres
+    IndiceBloque bloques_ocupados; // Contador de bloques ocupados
+
+    // Métrica de recorrido: nodos visitados por las liberaciones
+    // (solo la actualizan las estructuras enlazadas)
+    long long nodos_visitados_liberacion;
+    long long liberaciones_medidas;
+
+    // Histograma de huecos libres: tamaño → cuántos huecos de ese tamaño.
+    // Lo mantienen al día las estructuras que no tienen un índice propio
+    // por tamaño; el mayor hueco es su última clave.
+    std::map<IndiceBloque, IndiceBloque> histograma_huecos;
+    void registrar_hueco(IndiceBloque tamanio);
+    void retirar_hueco(IndiceBloque tamanio);
+    size_t memoria_histograma() const; // Bytes de histograma_huecos
+
+    // Rehacer el índice de huecos de la estructura a partir de `disco`.
+    // Lo llaman los constructores y todo lo que reemplaza el estado
+    // entero (inicializar_disco, cargar_estado, copiar_estado), así el
+    // índice nunca queda atrasado respecto de `disco`. Por defecto rehace
+    // el histograma; cada estructura lo redefine para su índice, sacando
+    // las rachas libres por palabras (recorrer_rachas_libres).
+    virtual void reconstruir();
+
+    // Para medir tiempos (CPU real)
+    std::chrono::high_resolution_clock::time_point tiempo_inicio;
 
-    int bloques_libres;   // Contador de bloques libres
-    int bloques_ocupados; // Contador de bloques ocupados
+    // Tiempo de dispositivo (virtual, no se duerme)
+    std::unique_ptr<ModeloDispositivo> dispositivo;
+    double reloj_virtual_us; // Suma de los costos cobrados por el modelo
 
-    // Para medir tiempos
-    std::chrono::high_resolution_clock::time_point tiempo_inicio;
+    // MÉTODO PROTEGIDO: Cobrar el tiempo de I/O de una operación ya ubicada
+    // (inicio = -1 para operaciones sin posición, como BUSQUEDA)
+    void simular_acceso_disco(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque num_bloques);
 
-    // MÉTODO PROTEGIDO: Simular delays de I/O
-    void simular_acceso_disco(TipoOperacion tipo, int num_bloques = 1);
+private:
+    // Formatos de archivo de estado (cargar_estado elige)
+    bool guardar_estado_binario(const std::string &archivo) const;
+    bool guardar_estado_texto(const std::string &archivo) const;
+    bool cargar_estado_binario(const std::string &archivo);
+    bool cargar_estado_texto(const std::string &archivo);
 
 public:
     // CONSTRUCTOR Y DESTRUCTOR
-    GestorDisco();
+    GestorDisco(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
     virtual ~GestorDisco() {} // Virtual para que las hijas liberen memoria correctamente
 
     // MÉTODOS VIRTUALES PUROS (= 0 significa "obligatorio implementar")
@@ -63,60 +206,113 @@ public:
 
     // Allocar: Llenar N bloques consecutivos
     // Retorna: posición de inicio si éxito, -1 si no hay espacio
-    virtual int allocar(int num_bloques) = 0;
+    virtual IndiceBloque allocar(IndiceBloque num_bloques) = 0;
 
     // Liberar: Vaciar N bloques desde una posición
     // Retorna: true si éxito, false si error
-    virtual bool liberar(int inicio, int num_bloques) = 0;
+    virtual bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) = 0;
 
     // Buscar: Encontrar el bloque libre más grande
     // Retorna: Tamaño del bloque más grande
-    virtual int buscar_bloque_mas_grande() = 0;
+    virtual IndiceBloque buscar_bloque_mas_grande() = 0;
 
     // Obtener nombre de la estructura (para reportes)
     virtual std::string obtener_nombre() const = 0;
 
+    // OPERACIONES POR LOTES (virtuales con implementación por defecto)
+    //
+    // Mismo resultado que llamar a allocar/liberar una vez por elemento,
+    // en ese orden. Por defecto son ese bucle; las estructuras que
+    // recorren sus huecos (listas, vector) los atienden en una pasada.
+
+    // Allocar un lote: resultado[i] = inicio del pedido i, o -1
+    virtual std::vector<IndiceBloque> allocar_lote(const std::vector<IndiceBloque> &tamanios);
+
+    // Liberar un lote de extensiones. Se ordenan por inicio antes de
+    // atenderlas, así la coalescencia avanza en un solo barrido.
+    // Retorna: cuántas se liberaron (las inválidas se saltean)
+    virtual size_t liberar_lote(std::vector<Extension> extensiones);
+
     // MÉTODOS COMUNES (implementados en disk_manager_base.cpp)
-    void inicializar_disco(float porcentaje_ocupado);
-    void guardar_estado(const std::string &archivo);
-    void cargar_estado(const std::string &archivo);
+    void inicializar_disco(float porcentaje_ocupado);                 // Semilla de random_device
+    void inicializar_disco(float porcentaje_ocupado, uint32_t semilla); // Reproducible
+    // false si no se pudo escribir entero (el archivo puede quedar a medias)
+    bool guardar_estado(const std::string &archivo, FormatoEstado formato = BINARIO) const;
+    // Detecta el formato por la cabecera; false si el archivo no sirve
+    // para este disco (el estado actual queda como estaba)
+    bool cargar_estado(const std::string &archivo);
+    void copiar_estado(const GestorDisco &origen); // Igual que cargar_estado, sin archivo
+
+    // Después de un corte: cargar el punto de control (si existe; si no,
+    // se parte del estado actual) y aplicar encima los registros del
+    // diario (diario.h), tal cual, sobre los bits. El índice se rehace
+    // una sola vez al final.
+    // Retorna: registros aplicados, o -1 si el diario o el punto de
+    // control (cuando existe) no sirven
+    long long recuperar(const std::string &punto_control, const std::string &archivo_diario);
 
     // Getters
-    int get_bloques_libres() const { return bloques_libres; }
-    int get_bloques_ocupados() const { return bloques_ocupados; }
-    float get_fragmentacion() const;
-
-    // Utilidades para cronometraje
+    IndiceBloque get_total_bloques() const { return total_bloques; }
+    int get_tamanio_bloque() const { return tamanio_bloque; }
+    IndiceBloque get_bloques_libres() const { return bloques_libres; }
+    IndiceBloque get_bloques_ocupados() const { return bloques_ocupados; }
+    const BitmapPalabras &get_disco() const { return disco; } // Para comparar estados
+    float get_fragmentacion() const; // O(1): contadores + mayor hueco
+    double get_nodos_por_liberacion() const;
+
+    // Memoria del índice de huecos de la estructura, en bytes (lo
+    // reservado, no solo lo usado). No cuenta `disco`, que todas tienen
+    // igual. Por defecto: solo el histograma de huecos.
+    virtual size_t uso_memoria() const;
+
+    // Mayor hueco libre en O(1), mantenido en cada allocar/liberar.
+    // Por defecto sale del histograma; los árboles usan su propio índice.
+    virtual IndiceBloque get_mayor_hueco() const;
+
+    // Comparar las métricas incrementales con un recorrido completo del
+    // disco (kernel SIMD). Para depuración: es O(n/64).
+    bool verificar_metricas() const;
+
+    // Utilidades para cronometraje (tiempo de CPU real)
     void iniciar_cronometro();
-    long long detener_cronometro(); // Retorna milisegundos
+    long long detener_cronometro(); // Retorna nanosegundos
+
+    // Tiempo de dispositivo simulado
+    void set_dispositivo(std::unique_ptr<ModeloDispositivo> modelo);
+    const ModeloDispositivo &get_dispositivo() const { return *dispositivo; }
+    double get_tiempo_virtual_us() const { return reloj_virtual_us; }
 };
 
 // Clase: MapaDeBits
-// Implementa la gestión usando un array booleano (bitmap).
-// Ventaja: simple, acceso directo O(1).
-// Desventaja: búsqueda lineal O(n) para bloques consecutivos.
+// Implementa la gestión usando un mapa de bits empaquetado en palabras
+// de 64 bits (ver bitmap_palabras.h).
+// Ventaja: simple, acceso directo O(1), salta 64 bloques por paso.
+// Desventaja: búsqueda lineal O(n/64) para bloques consecutivos.
 
 class MapaDeBits : public GestorDisco
 {
 private:
-    std::vector<bool> bitmap; // El mapa de bits
+    BitmapPalabras bitmap; // El mapa de bits
 
     // Buscar N bloques libres consecutivos
     // Retorna: Posición de inicio, o -1 si no encuentra
-    int buscar_bloques_consecutivos(int num_bloques);
+    IndiceBloque buscar_bloques_consecutivos(IndiceBloque num_bloques);
+
+    void reconstruir() override;
 
 public:
-    MapaDeBits();
+    MapaDeBits(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
     ~MapaDeBits() override {}
 
     // Implementación de métodos virtuales puros
-    int allocar(int num_bloques) override;
-    bool liberar(int inicio, int num_bloques) override;
-    int buscar_bloque_mas_grande() override;
+    IndiceBloque allocar(IndiceBloque num_bloques) override;
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) override;
+    IndiceBloque buscar_bloque_mas_grande() override;
     std::string obtener_nombre() const override { return "Mapa de Bits"; }
+    size_t uso_memoria() const override;
 
     // Método específico para debugging
-    void imprimir_estado(int inicio = 0, int fin = 64);
+    void imprimir_estado(IndiceBloque inicio = 0, IndiceBloque fin = 64);
 };
 
 // CLASE: ListaSimple
@@ -145,28 +341,35 @@ private:
     // Nodo de la lista
     struct Nodo
     {
-        int inicio;      // Bloque de inicio del hueco
-        int tamanio;     // Tamaño del hueco (cuántos bloques)
-        Nodo *siguiente; // Puntero al siguiente hueco
+        IndiceBloque inicio;  // Bloque de inicio del hueco
+        IndiceBloque tamanio; // Tamaño del hueco (cuántos bloques)
+        Nodo *siguiente;      // Puntero al siguiente hueco
 
-        Nodo(int ini, int tam) : inicio(ini), tamanio(tam), siguiente(nullptr) {}
+        Nodo(IndiceBloque ini, IndiceBloque tam) : inicio(ini), tamanio(tam), siguiente(nullptr) {}
     };
 
-    Nodo *cabeza; // Primer nodo de la lista
+    PoolNodos<Nodo> pool; // Arena de la que salen todos los nodos
+    Nodo *cabeza;         // Primer nodo de la lista
 
     // Métodos auxiliares privados
-    void insertar_ordenado(int inicio, int tamanio);
-    void coalescencia();                        // Unir bloques adyacentes
-    Nodo *buscar_mejor_ajuste(int num_bloques); // Best Fit
+    void reconstruir() override; // En bloque, por tramos en paralelo (construccion_listas.h)
+    // Coalescencia con vecinos; `desde` (opcional) es un nodo que empieza
+    // antes de `inicio` para no recorrer desde la cabeza. Retorna el nodo
+    // que quedó con el hueco.
+    Nodo *insertar_y_unir(IndiceBloque inicio, IndiceBloque tamanio, Nodo *desde = nullptr);
+    Nodo *buscar_mejor_ajuste(IndiceBloque num_bloques); // Best Fit
 
 public:
-    ListaSimple();
+    ListaSimple(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
     ~ListaSimple() override;
 
-    int allocar(int num_bloques) override;
-    bool liberar(int inicio, int num_bloques) override;
-    int buscar_bloque_mas_grande() override;
+    IndiceBloque allocar(IndiceBloque num_bloques) override;
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) override;
+    std::vector<IndiceBloque> allocar_lote(const std::vector<IndiceBloque> &tamanios) override;
+    size_t liberar_lote(std::vector<Extension> extensiones) override;
+    IndiceBloque buscar_bloque_mas_grande() override;
     std::string obtener_nombre() const override { return "Lista Simplemente Ligada"; }
+    size_t uso_memoria() const override;
 
     void imprimir_lista();
 };
@@ -197,34 +400,203 @@ private:
     // Nodo doblemente enlazado
     struct NodoDoble
     {
-        int inicio;
-        int tamanio;
+        IndiceBloque inicio;
+        IndiceBloque tamanio;
         NodoDoble *siguiente;
         NodoDoble *anterior; // ← NUEVA: puntero hacia atrás
 
-        NodoDoble(int ini, int tam)
+        NodoDoble(IndiceBloque ini, IndiceBloque tam)
             : inicio(ini), tamanio(tam), siguiente(nullptr), anterior(nullptr) {}
     };
 
+    PoolNodos<NodoDoble> pool; // Arena de la que salen todos los nodos
     NodoDoble *cabeza;
     NodoDoble *cola; // Para inserción eficiente al final
 
     // Métodos auxiliares
-    void insertar_ordenado(int inicio, int tamanio);
-    void coalescencia();
-    NodoDoble *buscar_mejor_ajuste(int num_bloques);
+    void reconstruir() override;
+    NodoDoble *insertar_y_unir(IndiceBloque inicio, IndiceBloque tamanio, NodoDoble *desde = nullptr);
+    NodoDoble *buscar_mejor_ajuste(IndiceBloque num_bloques);
     void eliminar_nodo(NodoDoble *nodo);
 
 public:
-    ListaDoble();
+    ListaDoble(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
     ~ListaDoble() override;
 
-    int allocar(int num_bloques) override;
-    bool liberar(int inicio, int num_bloques) override;
-    int buscar_bloque_mas_grande() override;
+    IndiceBloque allocar(IndiceBloque num_bloques) override;
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) override;
+    std::vector<IndiceBloque> allocar_lote(const std::vector<IndiceBloque> &tamanios) override;
+    size_t liberar_lote(std::vector<Extension> extensiones) override;
+    IndiceBloque buscar_bloque_mas_grande() override;
     std::string obtener_nombre() const override { return "Lista Doblemente Ligada"; }
+    size_t uso_memoria() const override;
 
     void imprimir_lista();
 };
 
+// CLASE: ArbolSegmentos
+//
+// IMPLEMENTA: Gestión usando un árbol de segmentos sobre los bloques
+//
+// CÓMO FUNCIONA:
+// Cada nodo cubre un rango de bloques y guarda tres longitudes:
+//
+//                [0-7] pre:0 suf:2 max:4
+//              ┌──────────┴──────────┐
+//   [0-3] = 1 0 0 0             [4-7] = 0 1 0 0
+//   pre:0 suf:3 max:3           pre:1 suf:2 max:2
+//   (1 = ocupado, 0 = libre; la racha de 4 cruza el medio)
+//
+// - prefijo: libres consecutivos desde el inicio del rango
+// - sufijo:  libres consecutivos hasta el final del rango
+// - maximo:  racha libre más larga dentro del rango
+//
+// Un padre se calcula con sus dos hijos, y el hueco más grande del disco
+// está siempre en la raíz.
+//
+// VENTAJAS:
+// - allocar (primer ajuste), liberar y marcar rangos en O(log n)
+// - Hueco más grande en O(1) (leer la raíz)
+//
+// DESVENTAJAS:
+// - Memoria proporcional al número de bloques (no al de huecos)
+// - Implementación más compleja (propagación perezosa de rangos)
+
+class ArbolSegmentos : public GestorDisco
+{
+private:
+    // Marca perezosa: rango pendiente de asignar a los hijos
+    enum Pendiente : unsigned char
+    {
+        NINGUNO,
+        TODO_LIBRE,
+        TODO_OCUPADO
+    };
+
+    IndiceBloque hojas; // Potencia de 2 >= total_bloques
+
+    // Arreglos indexados por nodo (raíz = 1, hijos de i = 2i y 2i+1)
+    std::vector<IndiceBloque> prefijo;
+    std::vector<IndiceBloque> sufijo;
+    std::vector<IndiceBloque> maximo;
+    std::vector<Pendiente> pendiente;
+
+    void combinar(IndiceBloque nodo, IndiceBloque largo_izq, IndiceBloque largo_der);
+    void aplicar(IndiceBloque nodo, IndiceBloque largo, Pendiente valor);
+    void propagar(IndiceBloque nodo, IndiceBloque largo);
+    void asignar_rango(IndiceBloque nodo, IndiceBloque izq, IndiceBloque der,
+                       IndiceBloque desde, IndiceBloque hasta, Pendiente valor);
+    IndiceBloque buscar_primer_ajuste(IndiceBloque num_bloques);
+    void reconstruir() override; // Por palabras; las uniformes quedan con marca perezosa
+
+public:
+    ArbolSegmentos(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
+    ~ArbolSegmentos() override {}
+
+    IndiceBloque allocar(IndiceBloque num_bloques) override;
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) override;
+    IndiceBloque buscar_bloque_mas_grande() override;
+    IndiceBloque get_mayor_hueco() const override;
+    std::string obtener_nombre() const override { return "Arbol de Segmentos"; }
+    size_t uso_memoria() const override;
+};
+
+// CLASE: ArbolExtensiones
+//
+// IMPLEMENTA: Gestión con árboles balanceados de extensiones (huecos)
+//
+// CÓMO FUNCIONA:
+// Cada hueco libre {inicio, tamanio} está en DOS índices a la vez:
+//
+// por_inicio   (inicio → tamanio):  10→5   20→3   100→50
+//   sirve para encontrar los vecinos al liberar (coalescencia)
+//
+// por_tamanio  (tamanio, inicio):   (3,20) (5,10) (50,100)
+//   sirve para el mejor ajuste: el primer par con tamanio >= N
+//
+// VENTAJAS:
+// - Best Fit en O(log n) (en lugar de recorrer todos los nodos)
+// - Liberar + unir con vecinos en O(log n)
+// - Hueco más grande en O(1) (último elemento de por_tamanio)
+//
+// DESVENTAJAS:
+// - Cada hueco se guarda dos veces (más memoria por nodo)
+
+class ArbolExtensiones : public GestorDisco
+{
+private:
+    std::map<IndiceBloque, IndiceBloque> por_inicio;             // inicio → tamanio
+    std::set<std::pair<IndiceBloque, IndiceBloque>> por_tamanio; // {tamanio, inicio}
+
+    void insertar_extension(IndiceBloque inicio, IndiceBloque tamanio);
+    void quitar_extension(std::map<IndiceBloque, IndiceBloque>::iterator it);
+    void reconstruir() override;
+
+public:
+    ArbolExtensiones(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
+    ~ArbolExtensiones() override {}
+
+    IndiceBloque allocar(IndiceBloque num_bloques) override;
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) override;
+    IndiceBloque buscar_bloque_mas_grande() override;
+    IndiceBloque get_mayor_hueco() const override;
+    std::string obtener_nombre() const override { return "Arbol de Extensiones"; }
+    size_t uso_memoria() const override;
+};
+
+// CLASE: VectorExtensiones
+//
+// IMPLEMENTA: Huecos libres en dos arreglos paralelos ordenados (SoA)
+//
+// CÓMO FUNCIONA:
+// En lugar de nodos enlazados, los huecos viven en memoria contigua:
+//
+// inicios:  [ 10 ][ 20 ][ 100 ]   ← ordenado por posición
+// tamanios: [  5 ][  3 ][  50 ]   ← tamanios[i] corresponde a inicios[i]
+//
+// - Liberar: búsqueda binaria sobre `inicios` para ubicar vecinos
+// - Best Fit: recorrido secuencial de `tamanios` (sin saltos de punteros,
+//   el compilador lo puede vectorizar)
+//
+// VENTAJAS:
+// - Sin punteros: recorridos amigables con la caché y el prefetcher
+// - 16 bytes por hueco (nodo de lista simple: 24, de lista doble: 32)
+//
+// DESVENTAJAS:
+// - Insertar/eliminar en medio mueve los elementos siguientes (memmove)
+
+class VectorExtensiones : public GestorDisco
+{
+private:
+    std::vector<IndiceBloque> inicios;  // Inicio de cada hueco (ordenado)
+    std::vector<IndiceBloque> tamanios; // Tamaño de cada hueco
+
+    size_t buscar_mejor_ajuste(IndiceBloque num_bloques) const; // Best Fit
+    void reconstruir() override;
+
+public:
+    VectorExtensiones(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
+    ~VectorExtensiones() override {}
+
+    IndiceBloque allocar(IndiceBloque num_bloques) override;
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques) override;
+    std::vector<IndiceBloque> allocar_lote(const std::vector<IndiceBloque> &pedidos) override;
+    size_t liberar_lote(std::vector<Extension> extensiones) override;
+    IndiceBloque buscar_bloque_mas_grande() override;
+    std::string obtener_nombre() const override { return "Vector de Extensiones"; }
+    size_t uso_memoria() const override;
+};
+
+// Crear una instancia de cada estructura, en el orden de los reportes
+// (Mapa de Bits, Lista Simple, Lista Doble, Árbol de Segmentos,
+//  Árbol de Extensiones, Vector de Extensiones)
+std::vector<std::unique_ptr<GestorDisco>> crear_gestores(IndiceBloque total_bloques = TOTAL_BLOQUES,
+                                                         int tamanio_bloque = TAMANIO_BLOQUE);
+
+// Crear solo la estructura número `indice` de ese orden
+// Retorna: nullptr si indice >= NUM_ESTRUCTURAS
+const size_t NUM_ESTRUCTURAS = 6;
+std::unique_ptr<GestorDisco> crear_gestor(size_t indice, IndiceBloque total_bloques = TOTAL_BLOQUES,
+                                          int tamanio_bloque = TAMANIO_BLOQUE);
+
 #endif // DISK_MANAGER_H
\ No newline at end of file
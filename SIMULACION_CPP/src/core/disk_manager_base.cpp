@@ -7,11 +7,17 @@
  */
 
 #include "disk_manager.h"
+#include "diario.h"
 #include <iostream>
 #include <fstream>
 #include <random>
-#include <thread>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Implementación de GestorDisco (clase base)
 
@@ -19,13 +25,21 @@
  * CONSTRUCTOR
  *
  * QUÉ HACE:
- * - Crea el disco con 1024 bloques (todos libres al inicio)
+ * - Crea el disco con `total_bloques` bloques (todos libres al inicio)
+ * - Guarda la geometría (bloques y bytes por bloque)
  * - Inicializa contadores
+ * - Usa un HDD como modelo de dispositivo por defecto (reloj en 0)
  */
-GestorDisco::GestorDisco()
-    : disco(TOTAL_BLOQUES, false), // Crear array de 1024, todos en false (libres)
-      bloques_libres(TOTAL_BLOQUES),
-      bloques_ocupados(0)
+GestorDisco::GestorDisco(IndiceBloque total_bloques, int tamanio_bloque)
+    : disco(total_bloques), // Crear bitmap de total_bloques, todos libres
+      total_bloques(total_bloques),
+      tamanio_bloque(tamanio_bloque),
+      bloques_libres(total_bloques),
+      bloques_ocupados(0),
+      nodos_visitados_liberacion(0),
+      liberaciones_medidas(0),
+      dispositivo(std::make_unique<ModeloHDD>(tamanio_bloque)),
+      reloj_virtual_us(0.0)
 {
     // Nada más que hacer aquí
 }
@@ -34,42 +48,30 @@ GestorDisco::GestorDisco()
  * SIMULAR_ACCESO_DISCO
  *
  * PROPÓSITO:
- * Simular que el disco físico tarda tiempo en leer/escribir.
+ * Cobrar el tiempo que el disco físico tardaría en la operación.
  *
  * POR QUÉ:
  * En un disco real (HDD):
- * - Mover el cabezal: 3-5ms (seek time)
- * - Esperar rotación: 2-4ms
- * - Leer/escribir: 1ms
- * Total: ~5-10ms por operación
+ * - Mover el cabezal: 0.5-15ms (seek time, depende de la distancia)
+ * - Esperar rotación: 0-8ms (depende de dónde esté el plato)
+ * - Leer/escribir: según cuántos bloques
  *
- * En tu computadora moderna todo pasa en nanosegundos,
- * entonces "dormimos" el programa para simular delays reales.
+ * Antes se "dormía" el programa; ahora el modelo de dispositivo calcula
+ * el costo y se suma a un reloj virtual. Las estructuras llaman a este
+ * método después de ubicar la operación, para que el modelo sepa a qué
+ * posición se mueve el cabezal.
  */
-void GestorDisco::simular_acceso_disco(TipoOperacion tipo, int num_bloques)
+void GestorDisco::simular_acceso_disco(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque num_bloques)
 {
-    int delay_ms = 0;
+    reloj_virtual_us += dispositivo->atender(tipo, inicio, num_bloques, reloj_virtual_us);
+}
 
-    switch (tipo)
-    {
-    case ALLOCACION:
-        // Allocar tarda más (buscar + escribir)
-        delay_ms = 5 * num_bloques; // 5ms por bloque
-        break;
-
-    case LIBERACION:
-        // Liberar tarda menos (solo marcar como libre)
-        delay_ms = 2 * num_bloques; // 2ms por bloque
-        break;
-
-    case BUSQUEDA:
-        // Buscar: escanear estructura
-        delay_ms = 1;
-        break;
-    }
+// set_dispositivo: cambiar el modelo de costo (el reloj no se reinicia)
 
-    // DORMIR el programa por delay_ms milisegundos
-    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+void GestorDisco::set_dispositivo(std::unique_ptr<ModeloDispositivo> modelo)
+{
+    if (modelo != nullptr)
+        dispositivo = std::move(modelo);
 }
 
 /*
@@ -79,7 +81,7 @@ void GestorDisco::simular_acceso_disco(TipoOperacion tipo, int num_bloques)
  * Llenar el disco aleatoriamente hasta alcanzar el porcentaje deseado.
  *
  * EJEMPLO:
- * Si porcentaje_ocupado = 0.70 (70%):
+ * Si porcentaje_ocupado = 0.70 (70%) con el disco por defecto:
  * - Debe ocupar 716 bloques (70% de 1024)
  * - Deja 308 bloques libres (30%)
  *
@@ -90,9 +92,15 @@ void GestorDisco::simular_acceso_disco(TipoOperacion tipo, int num_bloques)
  */
 void GestorDisco::inicializar_disco(float porcentaje_ocupado)
 {
-    // Generador de números aleatorios
     std::random_device rd;
-    std::mt19937 gen(rd());
+    inicializar_disco(porcentaje_ocupado, rd());
+}
+
+// Misma semilla → mismo disco (así las corridas se pueden repetir)
+void GestorDisco::inicializar_disco(float porcentaje_ocupado, uint32_t semilla)
+{
+    // Generador de números aleatorios
+    std::mt19937 gen(semilla);
     std::uniform_int_distribution<> dist(0, 99);
 
     int umbral = static_cast<int>(porcentaje_ocupado * 100);
@@ -100,11 +108,11 @@ void GestorDisco::inicializar_disco(float porcentaje_ocupado)
     bloques_ocupados = 0;
 
     // Para cada bloque, decidir si está ocupado
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
+    for (IndiceBloque i = 0; i < total_bloques; i++)
     {
         // Generar número aleatorio 0-99
         // Si es menor que umbral (70), marcar ocupado
-        disco[i] = (dist(gen) < umbral);
+        disco.asignar(i, dist(gen) < umbral);
 
         if (disco[i])
         {
@@ -116,33 +124,122 @@ void GestorDisco::inicializar_disco(float porcentaje_ocupado)
         }
     }
 
+    reconstruir();
+
     std::cout << "Disco inicializado: " << bloques_ocupados << " bloques ocupados ("
-              << (bloques_ocupados * 100.0 / TOTAL_BLOQUES) << "%)\n";
+              << (bloques_ocupados * 100.0 / total_bloques) << "%)\n";
 }
 
 /*
- * GUARDAR_ESTADO
+ * GUARDAR_ESTADO / CARGAR_ESTADO
  *
  * PROPÓSITO:
- * Guardar el estado del disco en un archivo de texto.
+ * Guardar el estado del disco en un archivo y volver a leerlo.
+ *
+ * FORMATO BINARIO (por defecto):
+ *  Cabecera, 32 bytes:
+ *   "DSCO" | versión u32 | marca de orden u32 | tamanio_bloque u32 |
+ *   total_bloques i64 | bloques_ocupados i64
+ *  Luego las palabras del bitmap tal cual (uint64_t, orden de la
+ *  máquina: la marca 0x01020304 lo verifica al cargar).
+ *  ~0.125 bytes por bloque: un volumen de 2^32 bloques son 512 MB.
+ *
+ * FORMATO TEXTO (exportar):
+ *  # Comentario
+ *  1 1 0 0 0 1 1 0 0 1 ...
+ *  (64 bloques por línea, ~2 bytes por bloque)
  *
- * FORMATO:
- * # Comentario
- * 1 1 0 0 0 1 1 0 0 1 ...
- * (64 bloques por línea)
+ * cargar_estado mira los primeros bytes: si es la magia binaria, mapea
+ * el archivo con mmap(MAP_PRIVATE) y `disco` usa esas páginas sin
+ * copiarlas. Lo que se escriba después no vuelve al archivo, pero las
+ * páginas todavía no escritas se siguen leyendo DE él: si alguien lo
+ * reescribe en su lugar, el disco en memoria cambia por debajo.
+ *
+ * Por eso guardar_estado (binario) nunca escribe sobre el archivo: arma
+ * `<archivo>.tmp`, lo fuerza a disco y lo renombra encima. El inodo
+ * viejo sigue vivo para quien lo tenga mapeado (incluso este mismo
+ * gestor, si se guarda sobre el archivo del que se cargó), y el guardado
+ * es atómico: o queda el estado anterior o el nuevo entero.
  */
-void GestorDisco::guardar_estado(const std::string &archivo)
+
+static const char MAGIA_ESTADO[4] = {'D', 'S', 'C', 'O'};
+static const uint32_t VERSION_ESTADO = 1;
+static const uint32_t MARCA_ORDEN = 0x01020304;
+
+struct CabeceraEstado
+{
+    char magia[4];
+    uint32_t version;
+    uint32_t orden;
+    uint32_t tamanio_bloque;
+    int64_t total_bloques;
+    int64_t bloques_ocupados;
+};
+static_assert(sizeof(CabeceraEstado) == 32, "las palabras deben quedar alineadas a 8 bytes");
+
+bool GestorDisco::guardar_estado(const std::string &archivo, FormatoEstado formato) const
+{
+    bool ok = (formato == TEXTO) ? guardar_estado_texto(archivo) : guardar_estado_binario(archivo);
+    if (ok)
+        std::cout << "Estado guardado en: " << archivo << "\n";
+    return ok;
+}
+
+bool GestorDisco::guardar_estado_binario(const std::string &archivo) const
+{
+    std::string temporal = archivo + ".tmp";
+    std::ofstream file(temporal, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        std::cerr << "Error al abrir archivo para guardar: " << temporal << "\n";
+        return false;
+    }
+
+    CabeceraEstado cabecera;
+    std::memcpy(cabecera.magia, MAGIA_ESTADO, sizeof(cabecera.magia));
+    cabecera.version = VERSION_ESTADO;
+    cabecera.orden = MARCA_ORDEN;
+    cabecera.tamanio_bloque = static_cast<uint32_t>(tamanio_bloque);
+    cabecera.total_bloques = total_bloques;
+    cabecera.bloques_ocupados = bloques_ocupados;
+
+    file.write(reinterpret_cast<const char *>(&cabecera), sizeof(cabecera));
+    file.write(reinterpret_cast<const char *>(disco.datos()), disco.num_palabras() * sizeof(uint64_t));
+
+    // close() vacía el buffer: una escritura corta (ENOSPC, EIO) puede
+    // aparecer recién acá
+    file.close();
+    bool ok = file.good();
+
+    // fsync antes del rename: si no, un corte puede dejar el nombre nuevo
+    // apuntando a datos que nunca llegaron al disco
+    int fd = ok ? open(temporal.c_str(), O_RDONLY) : -1;
+    ok = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0)
+        close(fd);
+    ok = ok && std::rename(temporal.c_str(), archivo.c_str()) == 0;
+    if (!ok)
+    {
+        std::remove(temporal.c_str());
+        std::cerr << "Error al escribir el estado: " << archivo << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool GestorDisco::guardar_estado_texto(const std::string &archivo) const
 {
     std::ofstream file(archivo);
 
     if (!file.is_open())
     {
         std::cerr << "Error al abrir archivo para guardar: " << archivo << "\n";
-        return;
+        return false;
     }
 
     file << "# Estado del disco (1 = ocupado, 0 = libre)\n";
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
+    for (IndiceBloque i = 0; i < total_bloques; i++)
     {
         file << (disco[i] ? "1" : "0");
         if ((i + 1) % 64 == 0)
@@ -151,54 +248,282 @@ void GestorDisco::guardar_estado(const std::string &archivo)
             file << " ";
     }
 
-    file.close();
-    std::cout << "Estado guardado en: " << archivo << "\n";
+    if (file.good())
+        file.close();
+    if (!file.good())
+    {
+        std::cerr << "Error al escribir el estado: " << archivo << "\n";
+        return false;
+    }
+    return true;
 }
 
-/*
- * CARGAR_ESTADO
- *
- * PROPÓSITO:
- * Leer el estado del disco desde un archivo.
- */
-void GestorDisco::cargar_estado(const std::string &archivo)
+bool GestorDisco::cargar_estado(const std::string &archivo)
 {
-    std::ifstream file(archivo);
+    char magia[sizeof(MAGIA_ESTADO)] = {};
+    {
+        std::ifstream file(archivo, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Error al abrir archivo para cargar: " << archivo << "\n";
+            return false;
+        }
+        file.read(magia, sizeof(magia));
+    }
 
-    if (!file.is_open())
+    bool ok = (std::memcmp(magia, MAGIA_ESTADO, sizeof(magia)) == 0) ? cargar_estado_binario(archivo)
+                                                                     : cargar_estado_texto(archivo);
+    if (!ok)
+        return false;
+    reconstruir();
+
+    std::cout << "Estado cargado desde: " << archivo << "\n";
+    return true;
+}
+
+// Retorna false (con mensaje en cerr) si el archivo no sirve para este
+// disco; en ese caso el estado actual no se toca
+
+bool GestorDisco::cargar_estado_binario(const std::string &archivo)
+{
+    int fd = open(archivo.c_str(), O_RDONLY);
+    if (fd < 0)
     {
         std::cerr << "Error al abrir archivo para cargar: " << archivo << "\n";
-        return;
+        return false;
     }
 
+    struct stat info;
+    size_t largo = 0;
+    void *mapa = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(CabeceraEstado)))
+    {
+        largo = static_cast<size_t>(info.st_size);
+        mapa = mmap(nullptr, largo, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // El mapeo sigue vivo sin el descriptor
+
+    if (mapa == MAP_FAILED)
+    {
+        std::cerr << "Estado binario ilegible: " << archivo << "\n";
+        return false;
+    }
+
+    const CabeceraEstado *cabecera = static_cast<const CabeceraEstado *>(mapa);
+    size_t palabras = static_cast<size_t>((total_bloques + BitmapPalabras::BITS_POR_PALABRA - 1) /
+                                          BitmapPalabras::BITS_POR_PALABRA);
+    const char *problema = nullptr;
+    if (cabecera->version != VERSION_ESTADO)
+        problema = "versión desconocida";
+    else if (cabecera->orden != MARCA_ORDEN)
+        problema = "orden de bytes de otra máquina";
+    else if (cabecera->total_bloques != total_bloques)
+        problema = "otro tamaño de disco";
+    else if (cabecera->tamanio_bloque != static_cast<uint32_t>(tamanio_bloque))
+        problema = "otro tamaño de bloque";
+    else if (largo != sizeof(CabeceraEstado) + palabras * sizeof(uint64_t))
+        problema = "largo incorrecto";
+
+    if (problema != nullptr)
+    {
+        std::cerr << "Estado binario inválido (" << problema << "): " << archivo << "\n";
+        munmap(mapa, largo);
+        return false;
+    }
+
+    int64_t ocupados_cabecera = cabecera->bloques_ocupados;
+    uint64_t *datos = reinterpret_cast<uint64_t *>(static_cast<char *>(mapa) + sizeof(CabeceraEstado));
+    std::shared_ptr<void> dueno(mapa, [largo](void *p)
+                                { munmap(p, largo); });
+    disco.adoptar(datos, total_bloques, std::move(dueno));
+
+    // Contadores desde los bits (kernel SIMD, una pasada); la cabecera
+    // solo sirve de control
+    bloques_ocupados = disco.resumen_rachas().ocupados;
+    bloques_libres = total_bloques - bloques_ocupados;
+    if (bloques_ocupados != ocupados_cabecera)
+    {
+        std::cerr << "Aviso: la cabecera de " << archivo << " dice " << ocupados_cabecera
+                  << " bloques ocupados y el bitmap " << bloques_ocupados << "\n";
+    }
+    return true;
+}
+
+bool GestorDisco::cargar_estado_texto(const std::string &archivo)
+{
+    std::ifstream file(archivo);
+
+    // Se lee a un bitmap aparte: si el archivo no alcanza, `disco` no se toca
+    BitmapPalabras leido(total_bloques);
     std::string linea;
-    int index = 0;
-    bloques_libres = 0;
-    bloques_ocupados = 0;
+    IndiceBloque index = 0;
+    IndiceBloque ocupados = 0;
 
-    while (std::getline(file, linea) && index < TOTAL_BLOQUES)
+    while (index < total_bloques && std::getline(file, linea))
     {
-        if (linea[0] == '#')
+        if (!linea.empty() && linea[0] == '#')
             continue; // Saltar comentarios
 
         for (char c : linea)
         {
             if (c == '0' || c == '1')
             {
-                disco[index] = (c == '1');
-                if (disco[index])
-                    bloques_ocupados++;
-                else
-                    bloques_libres++;
+                leido.asignar(index, c == '1');
+                if (c == '1')
+                    ocupados++;
                 index++;
-                if (index >= TOTAL_BLOQUES)
+                if (index >= total_bloques)
                     break;
             }
         }
     }
 
-    file.close();
-    std::cout << "Estado cargado desde: " << archivo << "\n";
+    if (file.bad() || index < total_bloques)
+    {
+        std::cerr << "Estado de texto inválido (" << index << " de " << total_bloques
+                  << " bloques): " << archivo << "\n";
+        return false;
+    }
+
+    disco = std::move(leido);
+    bloques_ocupados = ocupados;
+    bloques_libres = total_bloques - ocupados;
+    return true;
+}
+
+/*
+ * COPIAR_ESTADO
+ *
+ * PROPÓSITO:
+ * Lo mismo que cargar_estado pero desde otro gestor en memoria: varias
+ * tareas en paralelo pueden partir del mismo estado sin leer el archivo
+ * (ni escribir en la consola). Ambos discos deben tener el mismo tamaño.
+ */
+void GestorDisco::copiar_estado(const GestorDisco &origen)
+{
+    if (origen.total_bloques != total_bloques)
+    {
+        std::cerr << "copiar_estado: tamaños distintos (" << origen.total_bloques
+                  << " vs " << total_bloques << ")\n";
+        return;
+    }
+
+    disco = origen.disco;
+    bloques_libres = origen.bloques_libres;
+    bloques_ocupados = origen.bloques_ocupados;
+    reconstruir();
+}
+
+/*
+ * RECUPERAR
+ *
+ * PROPÓSITO:
+ * Volver al último estado confirmado después de un corte: punto de
+ * control + diario de escritura anticipada (ver diario.h).
+ *
+ * PROCESO:
+ * 1. Cargar el punto de control (si no existe, el estado actual es la base)
+ * 2. Aplicar cada registro en orden: ALLOCAR marca su rango ocupado,
+ *    LIBERAR lo deja libre. No se elige ninguna posición: es lo que
+ *    pasó, no se vuelve a decidir
+ * 3. reconstruir() una vez, con todos los registros ya aplicados
+ */
+long long GestorDisco::recuperar(const std::string &punto_control, const std::string &archivo_diario)
+{
+    IndiceBloque bloques_diario = 0;
+    std::vector<RegistroDiario> registros;
+    if (!leer_diario(archivo_diario, bloques_diario, registros))
+        return -1;
+    if (bloques_diario != total_bloques)
+    {
+        std::cerr << "recuperar: el diario es de un disco de " << bloques_diario
+                  << " bloques, no de " << total_bloques << "\n";
+        return -1;
+    }
+
+    // Un punto de control que existe pero no carga no se reemplaza por el
+    // estado actual: el diario solo tiene lo hecho DESPUÉS de él
+    if (std::ifstream(punto_control).good() && !cargar_estado(punto_control))
+    {
+        std::cerr << "recuperar: el punto de control " << punto_control << " no sirve\n";
+        return -1;
+    }
+
+    for (const RegistroDiario &registro : registros)
+    {
+        if (registro.inicio < 0 || registro.tamanio <= 0 ||
+            registro.inicio + registro.tamanio > total_bloques)
+        {
+            std::cerr << "recuperar: registro " << registro.secuencia << " fuera del disco\n";
+            continue;
+        }
+
+        if (registro.tipo == DIARIO_ALLOCAR)
+            bloques_ocupados += disco.marcar_rango(registro.inicio, registro.tamanio);
+        else
+            bloques_ocupados -= disco.limpiar_rango(registro.inicio, registro.tamanio);
+    }
+    bloques_libres = total_bloques - bloques_ocupados;
+    reconstruir();
+
+    return static_cast<long long>(registros.size());
+}
+
+/*
+ * HISTOGRAMA DE HUECOS
+ *
+ * PROPÓSITO:
+ * Saber el mayor hueco sin recorrer nada. Cada vez que un hueco nace,
+ * crece, se achica o desaparece, la estructura retira su tamaño viejo
+ * y registra el nuevo.
+ *
+ * EJEMPLO:
+ * huecos de 3, 3 y 10 → {3: 2, 10: 1} → mayor hueco = 10
+ * allocar 8 del de 10 → {2: 1, 3: 2}  → mayor hueco = 3
+ *
+ * COMPLEJIDAD: O(log t), t = cantidad de tamaños distintos
+ */
+void GestorDisco::registrar_hueco(IndiceBloque tamanio)
+{
+    if (tamanio > 0)
+        histograma_huecos[tamanio]++;
+}
+
+void GestorDisco::retirar_hueco(IndiceBloque tamanio)
+{
+    if (tamanio <= 0)
+        return;
+
+    auto it = histograma_huecos.find(tamanio);
+    if (it != histograma_huecos.end() && --it->second == 0)
+        histograma_huecos.erase(it);
+}
+
+size_t GestorDisco::memoria_histograma() const
+{
+    return histograma_huecos.size() *
+           (SOBRECARGA_NODO_ARBOL + sizeof(std::pair<const IndiceBloque, IndiceBloque>));
+}
+
+size_t GestorDisco::uso_memoria() const
+{
+    return memoria_histograma();
+}
+
+// reconstruir (por defecto): solo el histograma, una racha a la vez
+
+void GestorDisco::reconstruir()
+{
+    histograma_huecos.clear();
+    disco.recorrer_rachas_libres(0, total_bloques, [this](IndiceBloque, IndiceBloque tamanio)
+                                 { registrar_hueco(tamanio); });
+}
+
+IndiceBloque GestorDisco::get_mayor_hueco() const
+{
+    if (histograma_huecos.empty())
+        return 0;
+    return histograma_huecos.rbegin()->first;
 }
 
 /*
@@ -217,39 +542,18 @@ void GestorDisco::cargar_estado(const std::string &archivo)
  *
  * INTERPRETACIÓN:
  * 33.3% del espacio libre está fragmentado (en trozos pequeños).
+ *
+ * COSTO: O(1). Ambos valores se mantienen en cada allocar/liberar; el
+ * recorrido completo del disco queda para verificar_metricas().
  */
 float GestorDisco::get_fragmentacion() const
 {
-    // Recalcular número real de bloques libres por seguridad
-    int reales_libres = 0;
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
-    {
-        if (!disco[i])
-            reales_libres++;
-    }
-
-    if (reales_libres == 0)
+    if (bloques_libres <= 0)
         return 0.0;
 
-    // Encontrar el bloque libre más grande
-    int max_consecutivos = 0;
-    int consecutivos_actuales = 0;
-
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
-    {
-        if (!disco[i])
-        { // Bloque libre
-            consecutivos_actuales++;
-            max_consecutivos = std::max(max_consecutivos, consecutivos_actuales);
-        }
-        else
-        {
-            consecutivos_actuales = 0;
-        }
-    }
+    IndiceBloque max_consecutivos = get_mayor_hueco();
 
-    // Usar el recuento real para el cálculo (evita inconsistencias)
-    double frag = (static_cast<double>(reales_libres - max_consecutivos) * 100.0) / reales_libres;
+    double frag = (static_cast<double>(bloques_libres - max_consecutivos) * 100.0) / bloques_libres;
     if (frag < 0.0)
         frag = 0.0;
     if (frag > 100.0)
@@ -257,11 +561,75 @@ float GestorDisco::get_fragmentacion() const
     return static_cast<float>(frag);
 }
 
+/*
+ * VERIFICAR_METRICAS
+ *
+ * PROPÓSITO:
+ * Comprobar que los contadores incrementales coinciden con el disco real.
+ * Una sola pasada del kernel de rachas da ocupados y racha más larga.
+ */
+bool GestorDisco::verificar_metricas() const
+{
+    ResumenRachas resumen = disco.resumen_rachas();
+
+    return resumen.ocupados == bloques_ocupados &&
+           total_bloques - resumen.ocupados == bloques_libres &&
+           resumen.racha_maxima == get_mayor_hueco();
+}
+
+/*
+ * ALLOCAR_LOTE / LIBERAR_LOTE (implementación por defecto)
+ *
+ * PROPÓSITO:
+ * Para las estructuras cuya operación individual ya es O(log n) o salta
+ * por palabras (bitmap, árboles) basta con el bucle. Ordenar las
+ * liberaciones igual ayuda: el cabezal las recorre en un solo sentido.
+ */
+std::vector<IndiceBloque> GestorDisco::allocar_lote(const std::vector<IndiceBloque> &tamanios)
+{
+    std::vector<IndiceBloque> resultados;
+    resultados.reserve(tamanios.size());
+
+    for (IndiceBloque tamanio : tamanios)
+        resultados.push_back(allocar(tamanio));
+
+    return resultados;
+}
+
+size_t GestorDisco::liberar_lote(std::vector<Extension> extensiones)
+{
+    std::sort(extensiones.begin(), extensiones.end());
+
+    size_t liberadas = 0;
+    for (const Extension &extension : extensiones)
+    {
+        if (liberar(extension.first, extension.second))
+            liberadas++;
+    }
+    return liberadas;
+}
+
+/*
+ * GET_NODOS_POR_LIBERACION
+ *
+ * PROPÓSITO:
+ * Promedio de nodos que recorrió cada liberación (costo de encontrar
+ * la posición + unir con vecinos). 0 si la estructura no lo mide.
+ */
+double GestorDisco::get_nodos_por_liberacion() const
+{
+    if (liberaciones_medidas == 0)
+        return 0.0;
+    return static_cast<double>(nodos_visitados_liberacion) / liberaciones_medidas;
+}
+
 /*
  * CRONOMETRAJE
  *
  * PROPÓSITO:
- * Medir cuánto tarda una operación.
+ * Medir cuánto tiempo de CPU tarda una operación (en nanosegundos: sin
+ * el sleep, casi todo dura menos de un microsegundo y en µs se leería
+ * 0). El tiempo de dispositivo va aparte, en get_tiempo_virtual_us().
  */
 void GestorDisco::iniciar_cronometro()
 {
@@ -271,22 +639,80 @@ void GestorDisco::iniciar_cronometro()
 long long GestorDisco::detener_cronometro()
 {
     auto tiempo_fin = std::chrono::high_resolution_clock::now();
-    auto duracion = std::chrono::duration_cast<std::chrono::milliseconds>(
+    auto duracion = std::chrono::duration_cast<std::chrono::nanoseconds>(
         tiempo_fin - tiempo_inicio);
     return duracion.count();
 }
 
+/*
+ * CREAR_GESTOR / CREAR_GESTORES
+ *
+ * PROPÓSITO:
+ * Un solo lugar con la lista de estructuras a comparar: la simulación
+ * principal y los experimentos recorren el mismo vector. crear_gestor
+ * sirve de fábrica cuando hace falta una sola (p. ej. un gestor por
+ * grupo en GestorConcurrente).
+ */
+std::unique_ptr<GestorDisco> crear_gestor(size_t indice, IndiceBloque total_bloques, int tamanio_bloque)
+{
+    switch (indice)
+    {
+    case 0:
+        return std::make_unique<MapaDeBits>(total_bloques, tamanio_bloque);
+    case 1:
+        return std::make_unique<ListaSimple>(total_bloques, tamanio_bloque);
+    case 2:
+        return std::make_unique<ListaDoble>(total_bloques, tamanio_bloque);
+    case 3:
+        return std::make_unique<ArbolSegmentos>(total_bloques, tamanio_bloque);
+    case 4:
+        return std::make_unique<ArbolExtensiones>(total_bloques, tamanio_bloque);
+    case 5:
+        return std::make_unique<VectorExtensiones>(total_bloques, tamanio_bloque);
+    }
+    return nullptr;
+}
+
+std::vector<std::unique_ptr<GestorDisco>> crear_gestores(IndiceBloque total_bloques, int tamanio_bloque)
+{
+    std::vector<std::unique_ptr<GestorDisco>> gestores;
+    for (size_t i = 0; i < NUM_ESTRUCTURAS; i++)
+        gestores.push_back(crear_gestor(i, total_bloques, tamanio_bloque));
+    return gestores;
+}
+
 // IMPLEMENTACIÓN DE MapaDeBits
 
 /*
  * CONSTRUCTOR
  *
  * QUÉ HACE:
- * - Copia el estado del disco al bitmap
+ * - Copia el estado del disco al bitmap (reconstruir)
+ * - Registra cada racha libre en el histograma de huecos
  */
-MapaDeBits::MapaDeBits() : GestorDisco()
+MapaDeBits::MapaDeBits(IndiceBloque total_bloques, int tamanio_bloque)
+    : GestorDisco(total_bloques, tamanio_bloque)
+{
+    reconstruir();
+}
+
+// reconstruir: copiar las palabras de `disco` (O(palabras)) y rehacer el
+// histograma desde la copia
+
+void MapaDeBits::reconstruir()
 {
-    bitmap = disco; // Copiar estado inicial
+    bitmap = disco;
+
+    histograma_huecos.clear();
+    bitmap.recorrer_rachas_libres(0, total_bloques, [this](IndiceBloque, IndiceBloque tamanio)
+                                  { registrar_hueco(tamanio); });
+}
+
+// uso_memoria: las palabras del bitmap + el histograma
+
+size_t MapaDeBits::uso_memoria() const
+{
+    return bitmap.num_palabras() * sizeof(uint64_t) + memoria_histograma();
 }
 
 /*
@@ -296,11 +722,12 @@ MapaDeBits::MapaDeBits() : GestorDisco()
  * Buscar N bloques libres CONSECUTIVOS (uno tras otro).
  *
  * ALGORITMO:
- * 1. Recorrer el bitmap
- * 2. Contar bloques libres consecutivos
- * 3. Si encuentras N seguidos, retornar posición de inicio
+ * 1. Recorrer el bitmap palabra por palabra (64 bloques a la vez)
+ * 2. Saltar palabras llenas; sumar 64 por cada palabra vacía
+ * 3. En palabras mixtas, medir rachas con ctz/clz
+ * 4. Si encuentras N seguidos, retornar posición de inicio
  *
- * COMPLEJIDAD: O(n) - debe escanear todo en el peor caso
+ * COMPLEJIDAD: O(n/64) - debe escanear todo en el peor caso
  *
  * Ejemplo:
  * bitmap: [1][1][0][0][0][1][0][0][0][0]
@@ -309,29 +736,9 @@ MapaDeBits::MapaDeBits() : GestorDisco()
  *
  * buscar_bloques_consecutivos(3) -> retorna 2 (posición de inicio)
  */
-int MapaDeBits::buscar_bloques_consecutivos(int num_bloques)
+IndiceBloque MapaDeBits::buscar_bloques_consecutivos(IndiceBloque num_bloques)
 {
-    int consecutivos = 0;
-
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
-    {
-        if (!bitmap[i])
-        { // Bloque libre
-            consecutivos++;
-            if (consecutivos == num_bloques)
-            {
-                // ¡Encontrado! Retornar posición de inicio
-                return i - num_bloques + 1;
-            }
-        }
-        else
-        {
-            // Bloque ocupado, reiniciar contador
-            consecutivos = 0;
-        }
-    }
-
-    return -1; // No encontró suficientes bloques consecutivos
+    return bitmap.buscar_libres_consecutivos(num_bloques);
 }
 
 /*
@@ -341,32 +748,37 @@ int MapaDeBits::buscar_bloques_consecutivos(int num_bloques)
  * Ocupar (llenar) N bloques del disco.
  *
  * PROCESO:
- * 1. Simular delay de I/O
- * 2. Buscar N bloques libres consecutivos
- * 3. Marcarlos como ocupados
- * 4. Actualizar contadores
+ * 1. Buscar N bloques libres consecutivos
+ * 2. Marcarlos como ocupados
+ * 3. Actualizar contadores e histograma de huecos
+ * 4. Cobrar el tiempo de I/O en el reloj virtual
+ *
+ * El primer ajuste siempre cae al inicio de una racha libre: la racha
+ * de largo L pasa a medir L - N.
  */
-int MapaDeBits::allocar(int num_bloques)
+IndiceBloque MapaDeBits::allocar(IndiceBloque num_bloques)
 {
-    simular_acceso_disco(ALLOCACION, num_bloques);
-
-    int inicio = buscar_bloques_consecutivos(num_bloques);
+    IndiceBloque inicio = buscar_bloques_consecutivos(num_bloques);
 
     if (inicio == -1)
     {
         return -1; // No hay espacio suficiente
     }
 
-    // Marcar bloques como ocupados
-    for (int i = inicio; i < inicio + num_bloques; i++)
-    {
-        bitmap[i] = true;
-        disco[i] = true;
-    }
+    IndiceBloque racha = bitmap.racha_libre_desde(inicio);
+    retirar_hueco(racha);
+    registrar_hueco(racha - num_bloques);
+
+    // Marcar bloques como ocupados (máscaras por palabra)
+    bitmap.marcar_rango(inicio, num_bloques);
+    disco.marcar_rango(inicio, num_bloques);
 
     bloques_ocupados += num_bloques;
     bloques_libres -= num_bloques;
 
+    // Cobrar la escritura ya con la posición conocida
+    simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+
     return inicio;
 }
 
@@ -378,31 +790,44 @@ int MapaDeBits::allocar(int num_bloques)
  *
  * PROCESO:
  * 1. Validar parámetros
- * 2. Simular delay de I/O
+ * 2. Cobrar el tiempo de I/O en el reloj virtual
  * 3. Marcar bloques como libres
- * 4. Actualizar contadores
+ * 4. Actualizar contadores e histograma de huecos
+ *
+ * HISTOGRAMA:
+ * El hueco resultante va desde el inicio de la racha libre pegada por
+ * la izquierda hasta el final de la pegada por la derecha:
+ *
+ *   ...1 0 0 [1 1 1 1] 0 1...   liberar [1 1 1 1]
+ *        └─┘            └ absorbidas
+ *   ...1 0 0  0 0 0 0  0 1...   → un hueco de 7
+ *
+ * Las rachas que había dentro de ese tramo se retiran y se registra el
+ * tramo completo.
  */
-bool MapaDeBits::liberar(int inicio, int num_bloques)
+bool MapaDeBits::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
 {
     // Validación
-    if (inicio < 0 || inicio + num_bloques > TOTAL_BLOQUES)
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
     {
         return false;
     }
 
-    simular_acceso_disco(LIBERACION, num_bloques);
+    simular_acceso_disco(LIBERACION, inicio, num_bloques);
 
-    // Marcar bloques como libres
-    for (int i = inicio; i < inicio + num_bloques; i++)
-    {
-        if (bitmap[i])
-        { // Solo si estaba ocupado
-            bitmap[i] = false;
-            disco[i] = false;
-            bloques_ocupados--;
-            bloques_libres++;
-        }
-    }
+    IndiceBloque desde = inicio - bitmap.racha_libre_hasta(inicio);
+    IndiceBloque hasta = inicio + num_bloques;
+    hasta += bitmap.racha_libre_desde(hasta);
+
+    bitmap.recorrer_rachas_libres(desde, hasta, [this](IndiceBloque, IndiceBloque tamanio)
+                                  { retirar_hueco(tamanio); });
+    registrar_hueco(hasta - desde);
+
+    // Marcar bloques como libres (solo cuentan los que estaban ocupados)
+    IndiceBloque liberados = bitmap.limpiar_rango(inicio, num_bloques);
+    disco.limpiar_rango(inicio, num_bloques);
+    bloques_ocupados -= liberados;
+    bloques_libres += liberados;
 
     return true;
 }
@@ -414,29 +839,14 @@ bool MapaDeBits::liberar(int inicio, int num_bloques)
  * Encontrar el segmento de bloques libres más grande.
  *
  * ALGORITMO:
- * Escanear todo el bitmap y encontrar la secuencia más larga de libres.
+ * O(1): última clave del histograma de huecos. El recorrido completo
+ * con el kernel SIMD (kernel_rachas.cpp) queda en verificar_metricas().
  */
-int MapaDeBits::buscar_bloque_mas_grande()
+IndiceBloque MapaDeBits::buscar_bloque_mas_grande()
 {
-    simular_acceso_disco(BUSQUEDA);
-
-    int max_tamanio = 0;
-    int tamanio_actual = 0;
-
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
-    {
-        if (!bitmap[i])
-        {
-            tamanio_actual++;
-            max_tamanio = std::max(max_tamanio, tamanio_actual);
-        }
-        else
-        {
-            tamanio_actual = 0;
-        }
-    }
+    simular_acceso_disco(BUSQUEDA, -1, 0);
 
-    return max_tamanio;
+    return get_mayor_hueco();
 }
 
 /*
@@ -445,10 +855,10 @@ int MapaDeBits::buscar_bloque_mas_grande()
  * PROPÓSITO:
  * Mostrar visualmente el estado del bitmap (para debugging).
  */
-void MapaDeBits::imprimir_estado(int inicio, int fin)
+void MapaDeBits::imprimir_estado(IndiceBloque inicio, IndiceBloque fin)
 {
     std::cout << "Estado del Bitmap [" << inicio << "-" << fin << "]:\n";
-    for (int i = inicio; i <= fin && i < TOTAL_BLOQUES; i++)
+    for (IndiceBloque i = inicio; i <= fin && i < total_bloques; i++)
     {
         std::cout << (bitmap[i] ? "█" : "░");
         if ((i - inicio + 1) % 64 == 0)
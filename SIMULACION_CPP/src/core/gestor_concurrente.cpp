@@ -0,0 +1,157 @@
+/*
+ * gestor_concurrente.cpp
+ *
+ * Implementación del gestor por grupos de allocación.
+ */
+
+#include "gestor_concurrente.h"
+#include <algorithm>
+
+GestorConcurrente::GestorConcurrente(size_t num_grupos, const FabricaGestor &fabrica,
+                                     IndiceBloque total_bloques, int tamanio_bloque)
+    : total_bloques(total_bloques),
+      siguiente_hogar(0),
+      derrames(0)
+{
+    // Al menos un grupo, y al menos un bloque por grupo
+    num_grupos = std::max<size_t>(1, std::min<size_t>(num_grupos, total_bloques));
+    bloques_por_grupo = total_bloques / static_cast<IndiceBloque>(num_grupos);
+
+    for (size_t g = 0; g < num_grupos; g++)
+    {
+        auto grupo = std::make_unique<Grupo>();
+        grupo->base = static_cast<IndiceBloque>(g) * bloques_por_grupo;
+        IndiceBloque tamanio = (g + 1 == num_grupos) ? total_bloques - grupo->base : bloques_por_grupo;
+        grupo->gestor = fabrica(tamanio, tamanio_bloque);
+        grupos.push_back(std::move(grupo));
+    }
+}
+
+size_t GestorConcurrente::grupo_de(IndiceBloque bloque) const
+{
+    // El último grupo absorbe el resto de la división
+    return std::min<size_t>(static_cast<size_t>(bloque / bloques_por_grupo), grupos.size() - 1);
+}
+
+size_t GestorConcurrente::asignar_hogar()
+{
+    return siguiente_hogar.fetch_add(1) % grupos.size();
+}
+
+// hogar_del_hilo: se asigna la primera vez que el hilo usa este gestor
+// (si el hilo alterna entre dos gestores, se reasigna; sigue siendo correcto)
+
+size_t GestorConcurrente::hogar_del_hilo()
+{
+    thread_local const GestorConcurrente *dueno = nullptr;
+    thread_local size_t hogar = 0;
+
+    if (dueno != this)
+    {
+        dueno = this;
+        hogar = asignar_hogar();
+    }
+    return hogar;
+}
+
+IndiceBloque GestorConcurrente::allocar(IndiceBloque num_bloques)
+{
+    return allocar(num_bloques, hogar_del_hilo());
+}
+
+// ============================================================================
+// ALLOCAR (con hogar)
+//
+// 1. Probar el hogar con su mutex
+// 2. Si no hay lugar, recorrer los demás grupos en orden circular
+//    (hogar+1, hogar+2, ...): los hilos con hogares distintos empiezan el
+//    derrame en grupos distintos y no se apilan todos sobre el grupo 0
+// 3. Traducir la posición local del grupo a global
+// ============================================================================
+
+IndiceBloque GestorConcurrente::allocar(IndiceBloque num_bloques, size_t hogar)
+{
+    const size_t n = grupos.size();
+    hogar %= n;
+
+    for (size_t paso = 0; paso < n; paso++)
+    {
+        Grupo &grupo = *grupos[(hogar + paso) % n];
+        IndiceBloque inicio;
+        {
+            std::lock_guard<std::mutex> lock(grupo.mutex);
+            inicio = grupo.gestor->allocar(num_bloques);
+        }
+
+        if (inicio != -1)
+        {
+            if (paso > 0)
+                derrames.fetch_add(1, std::memory_order_relaxed);
+            return grupo.base + inicio;
+        }
+    }
+
+    return -1; // Ningún grupo tiene N bloques consecutivos
+}
+
+// liberar: partir el rango por grupos y liberar cada pedazo en su dueño
+
+bool GestorConcurrente::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
+    {
+        return false;
+    }
+
+    IndiceBloque fin = inicio + num_bloques;
+    bool exito = true;
+
+    while (inicio < fin)
+    {
+        size_t g = grupo_de(inicio);
+        Grupo &grupo = *grupos[g];
+        IndiceBloque fin_grupo = (g + 1 == grupos.size()) ? total_bloques : grupo.base + bloques_por_grupo;
+        IndiceBloque pedazo = std::min(fin, fin_grupo) - inicio;
+
+        {
+            std::lock_guard<std::mutex> lock(grupo.mutex);
+            exito = grupo.gestor->liberar(inicio - grupo.base, pedazo) && exito;
+        }
+        inicio += pedazo;
+    }
+
+    return exito;
+}
+
+IndiceBloque GestorConcurrente::get_bloques_libres()
+{
+    IndiceBloque libres = 0;
+    for (auto &grupo : grupos)
+    {
+        std::lock_guard<std::mutex> lock(grupo->mutex);
+        libres += grupo->gestor->get_bloques_libres();
+    }
+    return libres;
+}
+
+IndiceBloque GestorConcurrente::get_bloques_ocupados()
+{
+    IndiceBloque ocupados = 0;
+    for (auto &grupo : grupos)
+    {
+        std::lock_guard<std::mutex> lock(grupo->mutex);
+        ocupados += grupo->gestor->get_bloques_ocupados();
+    }
+    return ocupados;
+}
+
+bool GestorConcurrente::verificar_metricas()
+{
+    for (auto &grupo : grupos)
+    {
+        std::lock_guard<std::mutex> lock(grupo->mutex);
+        if (!grupo->gestor->verificar_metricas())
+            return false;
+    }
+    return true;
+}
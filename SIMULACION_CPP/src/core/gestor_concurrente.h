@@ -0,0 +1,86 @@
+/*
+ * gestor_concurrente.h
+ *
+ * Gestor seguro para varios hilos, dividido en grupos de allocación
+ * (como los "allocation groups" de XFS o los grupos de bloques de ext4).
+ *
+ * CÓMO FUNCIONA:
+ * El disco se parte en `num_grupos` rangos contiguos. Cada grupo tiene su
+ * propio mutex y su propio `GestorDisco` (cualquier estructura, creada con
+ * la fábrica) que solo ve sus bloques, numerados desde 0.
+ *
+ *  bloques:  [0 ........ B) [B ....... 2B) [2B ...... 3B) ...
+ *  grupo:         0              1              2
+ *
+ * - Cada hilo tiene un grupo "hogar" (repartidos en ronda la primera vez
+ *   que el hilo usa este gestor): hilos distintos casi nunca se cruzan
+ * - Si el hogar no tiene lugar, se derrama a los siguientes grupos en
+ *   orden circular
+ * - liberar() va al grupo dueño de cada bloque (un rango que cruza el
+ *   límite entre grupos se parte)
+ *
+ * RESTRICCIÓN:
+ * Una extensión nunca cruza grupos: no se puede allocar más que el
+ * tamaño de un grupo de una vez.
+ */
+
+#ifndef GESTOR_CONCURRENTE_H
+#define GESTOR_CONCURRENTE_H
+
+#include "disk_manager.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Crea el gestor de un grupo de `total_bloques` bloques
+typedef std::function<std::unique_ptr<GestorDisco>(IndiceBloque total_bloques, int tamanio_bloque)> FabricaGestor;
+
+class GestorConcurrente
+{
+private:
+    struct Grupo
+    {
+        std::mutex mutex;
+        std::unique_ptr<GestorDisco> gestor;
+        IndiceBloque base; // Primer bloque global del grupo
+    };
+
+    std::vector<std::unique_ptr<Grupo>> grupos; // Punteros: std::mutex no se mueve
+    IndiceBloque total_bloques;
+    IndiceBloque bloques_por_grupo; // El último grupo se lleva además el resto
+
+    std::atomic<size_t> siguiente_hogar;
+    std::atomic<long long> derrames; // Allocaciones atendidas fuera del hogar
+
+    size_t grupo_de(IndiceBloque bloque) const;
+    size_t hogar_del_hilo();
+
+public:
+    GestorConcurrente(size_t num_grupos, const FabricaGestor &fabrica,
+                      IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
+
+    GestorConcurrente(const GestorConcurrente &) = delete;
+    GestorConcurrente &operator=(const GestorConcurrente &) = delete;
+
+    // Mismo contrato que GestorDisco::allocar / liberar, con posiciones
+    // globales. Se pueden llamar desde cualquier hilo.
+    IndiceBloque allocar(IndiceBloque num_bloques);
+    IndiceBloque allocar(IndiceBloque num_bloques, size_t hogar); // Hogar explícito
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques);
+
+    // Próximo hogar de la ronda (para quien prefiera elegirlo a mano)
+    size_t asignar_hogar();
+
+    // Métricas: suman todos los grupos (toma cada mutex un momento)
+    IndiceBloque get_bloques_libres();
+    IndiceBloque get_bloques_ocupados();
+    bool verificar_metricas();
+
+    size_t get_num_grupos() const { return grupos.size(); }
+    IndiceBloque get_total_bloques() const { return total_bloques; }
+    long long get_derrames() const { return derrames.load(); }
+};
+
+#endif // GESTOR_CONCURRENTE_H
@@ -0,0 +1,97 @@
+/*
+ * histograma_latencia.cpp
+ *
+ * Cubetas logarítmicas y cálculo de percentiles.
+ */
+
+#include "histograma_latencia.h"
+#include <cmath>
+
+// Cubetas exactas (0 a 2^(BITS+1) - 1) + 32 por cada potencia de 2
+// restante hasta 2^63
+static const size_t NUM_CUBETAS = (64 - 5) * 32 + 32;
+
+HistogramaLatencia::HistogramaLatencia()
+    : cubetas(NUM_CUBETAS, 0),
+      cuenta(0),
+      suma_ns(0),
+      maximo_ns(0)
+{
+}
+
+// ============================================================================
+// INDICE_CUBETA / TOPE_CUBETA
+//
+// EJEMPLO (32 subcubetas):
+//   ns = 40    → índice 40 (exacto)
+//   ns = 100   → bit más alto 6, desplazamiento 1: 32 + (100 >> 1) = 82
+//                (cubre 100 y 101; tope 101)
+//   ns = 5000  → bit más alto 12, desplazamiento 7:
+//                (7 + 1) * 32 + (5000 >> 7) - 32 = 263 (cubre 4992..5119)
+// ============================================================================
+
+size_t HistogramaLatencia::indice_cubeta(uint64_t ns)
+{
+    const uint64_t exactas = uint64_t(2) << BITS_SUBCUBETA; // 64
+    if (ns < exactas)
+        return static_cast<size_t>(ns);
+
+    int bit_alto = 63 - __builtin_clzll(ns);
+    int desplazamiento = bit_alto - BITS_SUBCUBETA;
+    return static_cast<size_t>(desplazamiento + 1) * (size_t(1) << BITS_SUBCUBETA) +
+           static_cast<size_t>(ns >> desplazamiento) - (size_t(1) << BITS_SUBCUBETA);
+}
+
+uint64_t HistogramaLatencia::tope_cubeta(size_t indice)
+{
+    const size_t por_potencia = size_t(1) << BITS_SUBCUBETA;
+    if (indice < 2 * por_potencia)
+        return indice;
+
+    int desplazamiento = static_cast<int>(indice / por_potencia) - 1;
+    uint64_t sub = indice % por_potencia + por_potencia;
+    return ((sub + 1) << desplazamiento) - 1;
+}
+
+void HistogramaLatencia::registrar(uint64_t ns)
+{
+    cubetas[indice_cubeta(ns)]++;
+    cuenta++;
+    suma_ns += ns;
+    if (ns > maximo_ns)
+        maximo_ns = ns;
+}
+
+void HistogramaLatencia::combinar(const HistogramaLatencia &otro)
+{
+    for (size_t i = 0; i < NUM_CUBETAS; i++)
+        cubetas[i] += otro.cubetas[i];
+    cuenta += otro.cuenta;
+    suma_ns += otro.suma_ns;
+    if (otro.maximo_ns > maximo_ns)
+        maximo_ns = otro.maximo_ns;
+}
+
+// percentil: la cubeta donde el acumulado alcanza ceil(p · cuenta)
+
+uint64_t HistogramaLatencia::percentil(double p) const
+{
+    if (cuenta == 0)
+        return 0;
+
+    uint64_t objetivo = static_cast<uint64_t>(std::ceil(p * cuenta));
+    if (objetivo == 0)
+        objetivo = 1;
+
+    uint64_t acumulado = 0;
+    for (size_t i = 0; i < NUM_CUBETAS; i++)
+    {
+        acumulado += cubetas[i];
+        if (acumulado >= objetivo)
+        {
+            uint64_t tope = tope_cubeta(i);
+            return tope < maximo_ns ? tope : maximo_ns;
+        }
+    }
+    return maximo_ns;
+}
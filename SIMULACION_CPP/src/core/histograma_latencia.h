@@ -0,0 +1,52 @@
+/*
+ * histograma_latencia.h
+ *
+ * Histograma de latencias en nanosegundos con cubetas logarítmicas
+ * (al estilo HdrHistogram): memoria fija, registrar en O(1) y
+ * percentiles sin guardar ni ordenar cada muestra.
+ *
+ * CUBETAS:
+ * - 0 a 63 ns: una cubeta por valor (exacto)
+ * - Desde 64 ns: cada potencia de 2 se parte en 32 cubetas iguales
+ *   [64,66) [66,68) ... [2^k, 2^k + 2^(k-5)) ...
+ *   → error relativo ≤ 1/32 (≈3%) en cualquier escala, de ns a horas
+ *
+ * Un percentil devuelve el borde SUPERIOR de su cubeta (nunca subestima
+ * la cola) recortado al máximo observado, que se guarda exacto.
+ */
+
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class HistogramaLatencia
+{
+private:
+    static const int BITS_SUBCUBETA = 5; // 32 cubetas por potencia de 2
+
+    std::vector<uint64_t> cubetas;
+    uint64_t cuenta;
+    uint64_t suma_ns;
+    uint64_t maximo_ns;
+
+    static size_t indice_cubeta(uint64_t ns);
+    static uint64_t tope_cubeta(size_t indice); // Mayor valor que cae en ella
+
+public:
+    HistogramaLatencia();
+
+    void registrar(uint64_t ns);
+    void combinar(const HistogramaLatencia &otro); // Sumar las muestras de otro
+
+    // p en [0, 1]; 0 si no hay muestras
+    uint64_t percentil(double p) const;
+
+    uint64_t get_cuenta() const { return cuenta; }
+    uint64_t get_maximo() const { return maximo_ns; }
+    double get_media() const { return cuenta ? static_cast<double>(suma_ns) / cuenta : 0.0; }
+};
+
+#endif // HISTOGRAMA_LATENCIA_H
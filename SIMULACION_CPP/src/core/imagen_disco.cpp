@@ -0,0 +1,190 @@
+/*
+ * imagen_disco.cpp
+ *
+ * Dispositivo sobre un archivo imagen (ver imagen_disco.h): escrituras
+ * reales con pwritev, opcionalmente con O_DIRECT.
+ */
+
+#include "imagen_disco.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace
+{
+
+double us_desde(std::chrono::steady_clock::time_point comienzo)
+{
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(fin - comienzo).count();
+}
+
+// pwritev hasta escribir todo: si escribe de menos, se avanza sobre los
+// iovec ya escritos y se sigue desde ahí
+
+bool escribir_vector_completo(int fd, struct iovec *iov, int cantidad, off_t desplazamiento)
+{
+    while (cantidad > 0)
+    {
+        ssize_t escritos = pwritev(fd, iov, cantidad, desplazamiento);
+        if (escritos < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        desplazamiento += escritos;
+
+        size_t resto = static_cast<size_t>(escritos);
+        while (cantidad > 0 && resto >= iov->iov_len)
+        {
+            resto -= iov->iov_len;
+            iov++;
+            cantidad--;
+        }
+        if (cantidad > 0)
+        {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + resto;
+            iov->iov_len -= resto;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ImagenDisco::ImagenDisco(const std::string &ruta, IndiceBloque total_bloques,
+                         int tamanio_bloque, bool directo)
+    : fd(-1), ruta(ruta), total_bloques(total_bloques), tamanio_bloque(tamanio_bloque),
+      directo(directo), buffer(nullptr), generacion(0),
+      operaciones(0), llamadas(0), bloques_escritos(0), errores(0),
+      ultima_posicion(0), distancia_total(0)
+{
+    if (directo && tamanio_bloque % 512 != 0)
+    {
+        std::cerr << "O_DIRECT necesita bloques múltiplos de 512 bytes (hay " << tamanio_bloque << ")\n";
+        return;
+    }
+
+    // Reserva redondeada a la alineación (lo exige aligned_alloc)
+    size_t bytes = static_cast<size_t>(BLOQUES_POR_LLAMADA) * tamanio_bloque;
+    bytes = (bytes + ALINEACION - 1) / ALINEACION * ALINEACION;
+    buffer = static_cast<unsigned char *>(std::aligned_alloc(ALINEACION, bytes));
+    if (buffer == nullptr)
+    {
+        std::cerr << "Sin memoria para el buffer de la imagen\n";
+        return;
+    }
+    std::memset(buffer, 0xA5, bytes);
+
+    int banderas = O_RDWR | O_CREAT | (directo ? O_DIRECT : 0);
+    int abierto = open(ruta.c_str(), banderas, 0644);
+    if (abierto < 0)
+    {
+        std::cerr << "No se pudo abrir la imagen " << ruta
+                  << (directo && errno == EINVAL ? " (el sistema de archivos no acepta O_DIRECT)" : "")
+                  << ": " << std::strerror(errno) << "\n";
+        return;
+    }
+
+    off_t tamanio = static_cast<off_t>(total_bloques) * tamanio_bloque;
+    struct stat info;
+    if (fstat(abierto, &info) != 0 || (info.st_size < tamanio && ftruncate(abierto, tamanio) != 0))
+    {
+        std::cerr << "No se pudo dimensionar la imagen " << ruta << ": " << std::strerror(errno) << "\n";
+        close(abierto);
+        return;
+    }
+
+    fd = abierto;
+}
+
+ImagenDisco::~ImagenDisco()
+{
+    if (fd >= 0)
+        close(fd);
+    std::free(buffer);
+}
+
+// ============================================================================
+// ESCRIBIR_BLOQUES
+//
+// Por tramo de hasta BLOQUES_POR_LLAMADA bloques: sellar cada bloque del
+// buffer con {número de bloque, generación}, un iovec por bloque, y un
+// solo pwritev al desplazamiento del primero.
+// ============================================================================
+
+bool ImagenDisco::escribir_bloques(IndiceBloque inicio, IndiceBloque cantidad)
+{
+    struct iovec iov[BLOQUES_POR_LLAMADA];
+    generacion++;
+
+    for (IndiceBloque hecho = 0; hecho < cantidad; hecho += BLOQUES_POR_LLAMADA)
+    {
+        int tramo = static_cast<int>(std::min<IndiceBloque>(BLOQUES_POR_LLAMADA, cantidad - hecho));
+
+        for (int i = 0; i < tramo; i++)
+        {
+            unsigned char *bloque = buffer + static_cast<size_t>(i) * tamanio_bloque;
+            uint64_t sello[2] = {static_cast<uint64_t>(inicio + hecho + i), generacion};
+            std::memcpy(bloque, sello, std::min<size_t>(sizeof(sello), tamanio_bloque));
+
+            iov[i].iov_base = bloque;
+            iov[i].iov_len = static_cast<size_t>(tamanio_bloque);
+        }
+
+        llamadas++;
+        off_t desplazamiento = static_cast<off_t>(inicio + hecho) * tamanio_bloque;
+        if (!escribir_vector_completo(fd, iov, tramo, desplazamiento))
+            return false;
+        bloques_escritos += tramo;
+    }
+    return true;
+}
+
+double ImagenDisco::atender(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque num_bloques, double)
+{
+    if (fd < 0 || tipo == BUSQUEDA || inicio < 0 || num_bloques <= 0)
+        return 0.0;
+
+    IndiceBloque cantidad = (tipo == ALLOCACION) ? num_bloques : 1;
+    cantidad = std::min(cantidad, total_bloques - inicio);
+    if (cantidad <= 0)
+        return 0.0;
+
+    operaciones++;
+    distancia_total += std::abs(inicio - ultima_posicion);
+    ultima_posicion = inicio + cantidad;
+
+    auto comienzo = std::chrono::steady_clock::now();
+    if (!escribir_bloques(inicio, cantidad))
+    {
+        if (errores == 0)
+            std::cerr << "Error al escribir la imagen " << ruta << ": " << std::strerror(errno) << "\n";
+        errores++;
+    }
+    return us_desde(comienzo);
+}
+
+double ImagenDisco::sincronizar()
+{
+    if (fd < 0)
+        return 0.0;
+
+    auto comienzo = std::chrono::steady_clock::now();
+    if (fdatasync(fd) != 0)
+        errores++;
+    return us_desde(comienzo);
+}
+
+double ImagenDisco::get_distancia_media() const
+{
+    return operaciones ? static_cast<double>(distancia_total) / operaciones : 0.0;
+}
@@ -0,0 +1,108 @@
+/*
+ * imagen_disco.h
+ *
+ * Dispositivo REAL: en vez de sumar un costo calculado al reloj virtual,
+ * escribe los bloques en un archivo imagen del disco (total_bloques ×
+ * tamanio_bloque bytes) y cobra lo que tardó de verdad.
+ *
+ * QUÉ SE ESCRIBE:
+ * - ALLOCACION: todos los bloques de la extensión
+ * - LIBERACION: su primer bloque (como en los modelos: marcar el rango
+ *   libre toca el comienzo)
+ * - BUSQUEDA: nada (solo metadatos en memoria)
+ *
+ * Cada bloque lleva su número y una generación en los primeros 16 bytes,
+ * para que el contenido cambie de una escritura a otra.
+ *
+ * ESCRITURA VECTORIAL:
+ * Los bloques contiguos de una extensión salen en UNA llamada pwritev,
+ * un iovec por bloque, en vez de un pwrite por bloque:
+ *
+ *   extensión [100, 104)  →  pwritev(fd, {b100, b101, b102, b103}, 4,
+ *                                    100 * tamanio_bloque)
+ *
+ * Extensiones de más de BLOQUES_POR_LLAMADA bloques se parten.
+ *
+ * O_DIRECT (opcional):
+ * Sin él las escrituras quedan en el page cache y se mide sobre todo el
+ * costo de la llamada; con él van al dispositivo sin cache. Exige el
+ * buffer alineado (se reserva alineado a 4096) y desplazamientos y
+ * largos múltiplos del sector lógico: tamanio_bloque múltiplo de 512.
+ * sincronizar() (fdatasync) cierra la medición en los dos casos.
+ *
+ * Las estructuras no se enteran: se enchufa con set_dispositivo() como
+ * cualquier ModeloDispositivo, y get_tiempo_virtual_us() pasa a ser
+ * tiempo real de I/O.
+ */
+
+#ifndef IMAGEN_DISCO_H
+#define IMAGEN_DISCO_H
+
+#include "disk_manager.h"
+#include <cstdint>
+#include <string>
+
+class ImagenDisco : public ModeloDispositivo
+{
+private:
+    int fd;
+    std::string ruta;
+    IndiceBloque total_bloques;
+    int tamanio_bloque;
+    bool directo;
+
+    unsigned char *buffer; // BLOQUES_POR_LLAMADA bloques, alineado a 4096
+    uint64_t generacion;
+
+    // Contadores
+    long long operaciones;        // Operaciones que escribieron algo
+    long long llamadas;           // pwritev hechos
+    long long bloques_escritos;
+    long long errores;            // Escrituras que fallaron
+    IndiceBloque ultima_posicion; // Bloque siguiente al último escrito
+    long long distancia_total;    // Suma de |inicio - ultima_posicion|
+
+    // Escribir [inicio, inicio+cantidad) en llamadas de hasta
+    // BLOQUES_POR_LLAMADA bloques
+    bool escribir_bloques(IndiceBloque inicio, IndiceBloque cantidad);
+
+public:
+    static const int BLOQUES_POR_LLAMADA = 256; // iovecs por pwritev (< IOV_MAX)
+    static const size_t ALINEACION = 4096;
+
+    // Abrir (o crear) la imagen y llevarla al tamaño del disco (sin
+    // escribir: queda dispersa). Si falla, abierta() da false y el
+    // motivo sale por cerr.
+    ImagenDisco(const std::string &ruta, IndiceBloque total_bloques,
+                int tamanio_bloque = TAMANIO_BLOQUE, bool directo = false);
+    ~ImagenDisco();
+
+    ImagenDisco(const ImagenDisco &) = delete;
+    ImagenDisco &operator=(const ImagenDisco &) = delete;
+
+    bool abierta() const { return fd >= 0; }
+
+    // Escribe los bloques de la operación; retorna los µs REALES que tardó
+    double atender(TipoOperacion tipo, IndiceBloque inicio,
+                   IndiceBloque num_bloques, double ahora_us) override;
+    std::string nombre() const override { return directo ? "imagen (O_DIRECT)" : "imagen"; }
+
+    // fdatasync de la imagen; retorna los µs que tardó
+    double sincronizar();
+
+    int get_fd() const { return fd; }
+    int get_tamanio_bloque() const { return tamanio_bloque; }
+    IndiceBloque get_total_bloques() const { return total_bloques; }
+    bool es_directo() const { return directo; }
+    long long get_operaciones() const { return operaciones; }
+    long long get_llamadas() const { return llamadas; }
+    long long get_bloques_escritos() const { return bloques_escritos; }
+    long long get_errores() const { return errores; }
+
+    // Bloques saltados en promedio entre una escritura y la siguiente
+    // (0 = todo secuencial): qué tan dispersas deja las escrituras la
+    // estructura
+    double get_distancia_media() const;
+};
+
+#endif // IMAGEN_DISCO_H
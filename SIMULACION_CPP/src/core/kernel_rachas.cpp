@@ -0,0 +1,215 @@
+/*
+ * kernel_rachas.cpp
+ *
+ * Implementación del kernel popcount + racha libre más larga.
+ *
+ * IDEA:
+ * La mayoría de las palabras de un disco real son "uniformes": todo
+ * ocupado o todo libre. Con SIMD se clasifican varias palabras de un
+ * solo paso; solo las palabras mixtas se procesan una por una con
+ * ctz/clz/popcount.
+ *
+ * ESTADO QUE SE ARRASTRA ENTRE PALABRAS:
+ * - racha:  ceros consecutivos al final de lo ya recorrido
+ * - maxima: mejor racha cerrada hasta ahora
+ * - ocupados: total de unos
+ */
+
+#include "kernel_rachas.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNEL_RACHAS_X86 1
+#endif
+
+namespace
+{
+
+struct EstadoRachas
+{
+    int64_t racha = 0;
+    int64_t maxima = 0;
+    int64_t ocupados = 0;
+};
+
+const uint64_t PALABRA_LLENA = ~0ULL;
+
+/*
+ * Procesar una palabra mixta (ni 0 ni ~0).
+ *
+ * w = ...0001101100000 (bit 0 a la derecha)
+ *        └┬┘     └─┬─┘
+ *       sufijo   prefijo → cierra la racha que venía
+ *  Las rachas internas (entre el primer y el último 1) se miden
+ *  saltando unos y ceros con ctz.
+ */
+inline void procesar_palabra_mixta(EstadoRachas &e, uint64_t w)
+{
+    e.ocupados += __builtin_popcountll(w);
+
+    int prefijo = __builtin_ctzll(w);
+    int sufijo = __builtin_clzll(w);
+    e.maxima = std::max(e.maxima, e.racha + prefijo);
+
+    int pos = prefijo;
+    int fin = 64 - sufijo;
+    while (pos < fin)
+    {
+        pos += __builtin_ctzll(~(w >> pos)); // Saltar unos
+        if (pos >= fin)
+            break;
+        int ceros = __builtin_ctzll(w >> pos); // Hay un 1 antes de `fin`
+        e.maxima = std::max<int64_t>(e.maxima, ceros);
+        pos += ceros;
+    }
+
+    e.racha = sufijo;
+}
+
+inline void procesar_palabra(EstadoRachas &e, uint64_t w)
+{
+    if (w == 0)
+    {
+        e.racha += 64;
+    }
+    else if (w == PALABRA_LLENA)
+    {
+        e.ocupados += 64;
+        e.maxima = std::max(e.maxima, e.racha);
+        e.racha = 0;
+    }
+    else
+    {
+        procesar_palabra_mixta(e, w);
+    }
+}
+
+inline ResumenRachas cerrar(const EstadoRachas &e)
+{
+    return {e.ocupados, std::max(e.maxima, e.racha)};
+}
+
+ResumenRachas analizar_escalar(const uint64_t *palabras, int64_t n)
+{
+    EstadoRachas e;
+    for (int64_t i = 0; i < n; i++)
+        procesar_palabra(e, palabras[i]);
+    return cerrar(e);
+}
+
+#ifdef KERNEL_RACHAS_X86
+
+// SSE2: 2 palabras por paso (SSE2 es parte de la base de x86-64)
+__attribute__((target("sse2")))
+ResumenRachas analizar_sse2(const uint64_t *palabras, int64_t n)
+{
+    EstadoRachas e;
+    const __m128i ceros = _mm_setzero_si128();
+    const __m128i unos = _mm_set1_epi32(-1);
+    int64_t i = 0;
+
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(palabras + i));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, ceros)) == 0xFFFF)
+        {
+            e.racha += 128;
+        }
+        else if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, unos)) == 0xFFFF)
+        {
+            e.ocupados += 128;
+            e.maxima = std::max(e.maxima, e.racha);
+            e.racha = 0;
+        }
+        else
+        {
+            procesar_palabra(e, palabras[i]);
+            procesar_palabra(e, palabras[i + 1]);
+        }
+    }
+
+    for (; i < n; i++)
+        procesar_palabra(e, palabras[i]);
+    return cerrar(e);
+}
+
+// AVX2: 4 palabras por paso; popcnt/tzcnt nativos en las mixtas
+__attribute__((target("avx2,popcnt,bmi")))
+ResumenRachas analizar_avx2(const uint64_t *palabras, int64_t n)
+{
+    EstadoRachas e;
+    const __m256i unos = _mm256_set1_epi32(-1);
+    int64_t i = 0;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(palabras + i));
+
+        if (_mm256_testz_si256(v, v))
+        {
+            e.racha += 256; // 4 palabras libres
+        }
+        else if (_mm256_testc_si256(v, unos))
+        {
+            e.ocupados += 256; // 4 palabras llenas
+            e.maxima = std::max(e.maxima, e.racha);
+            e.racha = 0;
+        }
+        else
+        {
+            for (int k = 0; k < 4; k++)
+                procesar_palabra(e, palabras[i + k]);
+        }
+    }
+
+    for (; i < n; i++)
+        procesar_palabra(e, palabras[i]);
+    return cerrar(e);
+}
+
+#endif // KERNEL_RACHAS_X86
+
+typedef ResumenRachas (*FuncionKernel)(const uint64_t *, int64_t);
+
+struct SeleccionKernel
+{
+    FuncionKernel funcion;
+    const char *nombre;
+};
+
+SeleccionKernel seleccionar_kernel()
+{
+#ifdef KERNEL_RACHAS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") &&
+        __builtin_cpu_supports("bmi"))
+    {
+        return {analizar_avx2, "avx2"};
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return {analizar_sse2, "sse2"};
+    }
+#endif
+    return {analizar_escalar, "escalar"};
+}
+
+const SeleccionKernel &kernel_seleccionado()
+{
+    static const SeleccionKernel seleccion = seleccionar_kernel();
+    return seleccion;
+}
+
+} // namespace
+
+ResumenRachas analizar_rachas(const uint64_t *palabras, int64_t num_palabras)
+{
+    return kernel_seleccionado().funcion(palabras, num_palabras);
+}
+
+const char *kernel_rachas_activo()
+{
+    return kernel_seleccionado().nombre;
+}
@@ -0,0 +1,29 @@
+/*
+ * kernel_rachas.h
+ *
+ * Kernel que recorre un mapa de bits UNA sola vez y calcula a la vez:
+ * - cuántos bits están en 1 (popcount → bloques ocupados)
+ * - la racha más larga de bits en 0 (hueco libre más grande)
+ *
+ * Se elige en tiempo de ejecución la mejor variante disponible:
+ * AVX2 (4 palabras por paso), SSE2 (2 palabras por paso) o escalar.
+ */
+
+#ifndef KERNEL_RACHAS_H
+#define KERNEL_RACHAS_H
+
+#include <cstdint>
+
+struct ResumenRachas
+{
+    int64_t ocupados;     // Bits en 1 (incluye los de relleno)
+    int64_t racha_maxima; // Racha más larga de bits en 0
+};
+
+// Analizar `num_palabras` palabras con la variante seleccionada
+ResumenRachas analizar_rachas(const uint64_t *palabras, int64_t num_palabras);
+
+// Nombre de la variante activa ("avx2", "sse2" o "escalar")
+const char *kernel_rachas_activo();
+
+#endif // KERNEL_RACHAS_H
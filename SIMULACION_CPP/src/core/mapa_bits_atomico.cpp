@@ -0,0 +1,275 @@
+/*
+ * mapa_bits_atomico.cpp
+ *
+ * Implementación del mapa de bits con compare-and-swap.
+ */
+
+#include "mapa_bits_atomico.h"
+#include <algorithm>
+
+MapaDeBitsAtomico::MapaDeBitsAtomico(IndiceBloque total_bloques, int tamanio_bloque)
+    : num_palabras((total_bloques + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA),
+      total_bloques(total_bloques),
+      tamanio_bloque(tamanio_bloque),
+      bloques_ocupados(0),
+      siguiente_hilo(0),
+      reintentos_cas(0),
+      retrocesos(0)
+{
+    palabras = std::make_unique<std::atomic<uint64_t>[]>(num_palabras);
+    for (int64_t i = 0; i < num_palabras; i++)
+        palabras[i].store(0, std::memory_order_relaxed);
+
+    // Sellar el relleno de la última palabra
+    int sobrantes = static_cast<int>(total_bloques % BITS_POR_PALABRA);
+    if (sobrantes != 0)
+        palabras[num_palabras - 1].store(mascara_rango(sobrantes, BITS_POR_PALABRA), std::memory_order_relaxed);
+}
+
+uint64_t MapaDeBitsAtomico::mascara_rango(int desde, int hasta)
+{
+    if (hasta - desde >= BITS_POR_PALABRA)
+        return ~0ULL;
+    return ((1ULL << (hasta - desde)) - 1) << desde;
+}
+
+// cursor_del_hilo: palabra donde este hilo empieza a buscar. La primera
+// vez se elige por hash de Fibonacci del número de hilo (bien repartida);
+// después es la palabra de su última allocación.
+
+int64_t &MapaDeBitsAtomico::cursor_del_hilo()
+{
+    thread_local const MapaDeBitsAtomico *dueno = nullptr;
+    thread_local int64_t cursor = 0;
+
+    if (dueno != this)
+    {
+        dueno = this;
+        uint64_t numero = siguiente_hilo.fetch_add(1, std::memory_order_relaxed);
+        cursor = static_cast<int64_t>(((numero * 0x9E3779B97F4A7C15ULL) >> 32) % num_palabras);
+    }
+    return cursor;
+}
+
+// ============================================================================
+// COMIENZOS LIBRES DE UNA PALABRA
+//
+// Bit i encendido ⇔ los bits i..i+N-1 están libres. Se parte de ~v y se
+// hace AND con copias corridas duplicando el largo cubierto:
+//   cubre 1 → 2 → 4 → ... → N   (log2 N pasos)
+// El >> mete ceros por arriba: lo que se sale de la palabra cuenta como
+// ocupado, así que una racha nunca pasa a la palabra siguiente.
+// ============================================================================
+
+static uint64_t comienzos_libres(uint64_t ocupados, IndiceBloque num_bloques)
+{
+    uint64_t m = ~ocupados;
+    IndiceBloque cubierto = 1;
+    while (cubierto < num_bloques && m != 0)
+    {
+        IndiceBloque paso = std::min(cubierto, num_bloques - cubierto);
+        m &= m >> paso;
+        cubierto += paso;
+    }
+    return m;
+}
+
+IndiceBloque MapaDeBitsAtomico::allocar_en_palabra(IndiceBloque num_bloques)
+{
+    int64_t &cursor = cursor_del_hilo();
+
+    for (int64_t k = 0; k < num_palabras; k++)
+    {
+        int64_t w = (cursor + k) % num_palabras;
+        uint64_t valor = palabras[w].load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            uint64_t comienzos = comienzos_libres(valor, num_bloques);
+            if (comienzos == 0)
+                break; // No entra en esta palabra: la siguiente
+
+            int bit = __builtin_ctzll(comienzos);
+            uint64_t mascara = mascara_rango(bit, bit + static_cast<int>(num_bloques));
+
+            // Si falla, `valor` trae lo que dejó el otro hilo
+            if (palabras[w].compare_exchange_weak(valor, valor | mascara,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed))
+            {
+                cursor = w;
+                return w * BITS_POR_PALABRA + bit;
+            }
+            reintentos_cas.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    return -1;
+}
+
+// ============================================================================
+// BUSCAR_CANDIDATO (racha que cruza palabras, lectura sin reclamar)
+//
+// Una racha que cruza palabras está hecha de: los bits libres ALTOS de una
+// palabra, palabras completas libres y los bits libres BAJOS de la última.
+// Por palabra alcanza con ctz (cuánto sigue la racha abierta) y clz
+// (cuánto empieza arriba). El resultado puede quedar viejo enseguida:
+// reclamar() lo verifica.
+// ============================================================================
+
+IndiceBloque MapaDeBitsAtomico::buscar_candidato(IndiceBloque num_bloques) const
+{
+    IndiceBloque inicio = 0;
+    IndiceBloque largo = 0;
+
+    for (int64_t w = 0; w < num_palabras; w++)
+    {
+        uint64_t valor = palabras[w].load(std::memory_order_relaxed);
+
+        if (valor == 0)
+        {
+            if (largo == 0)
+                inicio = w * BITS_POR_PALABRA;
+            largo += BITS_POR_PALABRA;
+        }
+        else
+        {
+            if (largo == 0)
+                inicio = w * BITS_POR_PALABRA;
+            largo += __builtin_ctzll(valor);
+            if (largo >= num_bloques)
+                return inicio;
+
+            int altos = __builtin_clzll(valor);
+            inicio = (w + 1) * BITS_POR_PALABRA - altos;
+            largo = altos;
+        }
+
+        if (largo >= num_bloques)
+            return inicio;
+    }
+
+    return -1;
+}
+
+// reclamar: CAS palabra por palabra exigiendo que los bits sigan libres;
+// ante el primer conflicto se deshace lo reclamado
+
+bool MapaDeBitsAtomico::reclamar(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    IndiceBloque fin = inicio + num_bloques;
+    int64_t primera = inicio / BITS_POR_PALABRA;
+    int64_t ultima = (fin - 1) / BITS_POR_PALABRA;
+
+    for (int64_t w = primera; w <= ultima; w++)
+    {
+        int desde = (w == primera) ? static_cast<int>(inicio % BITS_POR_PALABRA) : 0;
+        int hasta = (w == ultima) ? static_cast<int>(fin - w * BITS_POR_PALABRA) : BITS_POR_PALABRA;
+        uint64_t mascara = mascara_rango(desde, hasta);
+
+        uint64_t valor = palabras[w].load(std::memory_order_relaxed);
+        bool reclamada = false;
+        while ((valor & mascara) == 0)
+        {
+            if (palabras[w].compare_exchange_weak(valor, valor | mascara,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed))
+            {
+                reclamada = true;
+                break;
+            }
+            reintentos_cas.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!reclamada)
+        {
+            // Deshacer las palabras anteriores (todavía no se contaron)
+            limpiar_bits(inicio, w * BITS_POR_PALABRA + desde);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+IndiceBloque MapaDeBitsAtomico::allocar_varias_palabras(IndiceBloque num_bloques)
+{
+    while (true)
+    {
+        IndiceBloque inicio = buscar_candidato(num_bloques);
+        if (inicio == -1)
+            return -1;
+        if (reclamar(inicio, num_bloques))
+            return inicio;
+        retrocesos.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// ALLOCAR
+//
+// 1. Si cabe en una palabra: una racha dentro de alguna palabra (un CAS)
+// 2. Si no (o ninguna palabra tiene lugar): racha que cruza palabras
+// ============================================================================
+
+IndiceBloque MapaDeBitsAtomico::allocar(IndiceBloque num_bloques)
+{
+    if (num_bloques <= 0 || num_bloques > total_bloques)
+    {
+        return -1;
+    }
+
+    IndiceBloque inicio = -1;
+    if (num_bloques <= BITS_POR_PALABRA)
+        inicio = allocar_en_palabra(num_bloques);
+    if (inicio == -1)
+        inicio = allocar_varias_palabras(num_bloques);
+
+    if (inicio != -1)
+        bloques_ocupados.fetch_add(num_bloques, std::memory_order_relaxed);
+    return inicio;
+}
+
+// limpiar_bits: fetch_and por palabra sobre [inicio, fin)
+// Retorna: cuántos bits estaban ocupados
+
+IndiceBloque MapaDeBitsAtomico::limpiar_bits(IndiceBloque inicio, IndiceBloque fin)
+{
+    IndiceBloque limpiados = 0;
+
+    for (int64_t w = inicio / BITS_POR_PALABRA; w * BITS_POR_PALABRA < fin; w++)
+    {
+        int desde = static_cast<int>(std::max<IndiceBloque>(inicio - w * BITS_POR_PALABRA, 0));
+        int hasta = static_cast<int>(std::min<IndiceBloque>(fin - w * BITS_POR_PALABRA, BITS_POR_PALABRA));
+        uint64_t mascara = mascara_rango(desde, hasta);
+
+        uint64_t anterior = palabras[w].fetch_and(~mascara, std::memory_order_release);
+        limpiados += __builtin_popcountll(anterior & mascara);
+    }
+
+    return limpiados;
+}
+
+// liberar: nunca falla por otros hilos (fetch_and no se reintenta)
+
+bool MapaDeBitsAtomico::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    if (inicio < 0 || num_bloques < 0 || inicio + num_bloques > total_bloques)
+    {
+        return false;
+    }
+
+    IndiceBloque liberados = limpiar_bits(inicio, inicio + num_bloques);
+    bloques_ocupados.fetch_sub(liberados, std::memory_order_relaxed);
+    return true;
+}
+
+bool MapaDeBitsAtomico::verificar_metricas() const
+{
+    IndiceBloque ocupados = 0;
+    for (int64_t w = 0; w < num_palabras; w++)
+        ocupados += __builtin_popcountll(palabras[w].load());
+
+    IndiceBloque relleno = num_palabras * BITS_POR_PALABRA - total_bloques;
+    return ocupados - relleno == bloques_ocupados.load();
+}
@@ -0,0 +1,89 @@
+/*
+ * mapa_bits_atomico.h
+ *
+ * Mapa de bits sin locks: cada palabra es un std::atomic<uint64_t> y los
+ * hilos se coordinan solo con operaciones atómicas.
+ *
+ * CONVENCIÓN (igual que BitmapPalabras):
+ * bit = 1 → ocupado, bit = 0 → libre; el relleno de la última palabra
+ * queda en 1 para siempre.
+ *
+ * PROTOCOLO:
+ * - N <= 64 (cabe en una palabra): buscar en la palabra una racha de N
+ *   ceros y reclamarla con UN compare_exchange. Si otro hilo cambió la
+ *   palabra, el CAS falla, trae el valor nuevo y se vuelve a buscar ahí.
+ * - Racha que cruza palabras: buscar un candidato leyendo sin reclamar y
+ *   después reclamar palabra por palabra (CAS que exige que esos bits
+ *   sigan en 0). Si alguna ya no está libre, se deshacen las palabras
+ *   ya reclamadas (fetch_and) y se busca otro candidato.
+ * - Liberar: fetch_and con la máscara negada en cada palabra; nunca falla.
+ *
+ * Cada hilo empieza a buscar en su propia palabra (repartidas al azar la
+ * primera vez y después la de su última allocación): los hilos no se
+ * pisan todos en la palabra 0.
+ *
+ * DIFERENCIAS CON MapaDeBits:
+ * - No es un GestorDisco: sin reloj virtual ni histograma de huecos
+ *   (serían estado compartido con lock). Solo mide latencia de CPU.
+ * - No es "primer ajuste" estricto: una racha corta se busca primero
+ *   dentro de cada palabra, y el punto de partida depende del hilo.
+ */
+
+#ifndef MAPA_BITS_ATOMICO_H
+#define MAPA_BITS_ATOMICO_H
+
+#include "disk_manager.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class MapaDeBitsAtomico
+{
+private:
+    static const int BITS_POR_PALABRA = 64;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> palabras;
+    int64_t num_palabras;
+    IndiceBloque total_bloques;
+    int tamanio_bloque;
+
+    std::atomic<IndiceBloque> bloques_ocupados;
+    std::atomic<uint64_t> siguiente_hilo;     // Para repartir los puntos de partida
+    std::atomic<long long> reintentos_cas;    // CAS que fallaron por otro hilo
+    std::atomic<long long> retrocesos;        // Rachas multi-palabra deshechas
+
+    static uint64_t mascara_rango(int desde, int hasta);
+    int64_t &cursor_del_hilo();
+
+    IndiceBloque allocar_en_palabra(IndiceBloque num_bloques);
+    IndiceBloque allocar_varias_palabras(IndiceBloque num_bloques);
+    IndiceBloque buscar_candidato(IndiceBloque num_bloques) const;
+    bool reclamar(IndiceBloque inicio, IndiceBloque num_bloques);
+    IndiceBloque limpiar_bits(IndiceBloque inicio, IndiceBloque fin);
+
+public:
+    explicit MapaDeBitsAtomico(IndiceBloque total_bloques = TOTAL_BLOQUES, int tamanio_bloque = TAMANIO_BLOQUE);
+
+    MapaDeBitsAtomico(const MapaDeBitsAtomico &) = delete;
+    MapaDeBitsAtomico &operator=(const MapaDeBitsAtomico &) = delete;
+
+    // Mismo contrato que GestorDisco::allocar / liberar; seguros desde
+    // cualquier hilo
+    IndiceBloque allocar(IndiceBloque num_bloques);
+    bool liberar(IndiceBloque inicio, IndiceBloque num_bloques);
+
+    IndiceBloque get_total_bloques() const { return total_bloques; }
+    int get_tamanio_bloque() const { return tamanio_bloque; }
+    IndiceBloque get_bloques_ocupados() const { return bloques_ocupados.load(); }
+    IndiceBloque get_bloques_libres() const { return total_bloques - bloques_ocupados.load(); }
+    long long get_reintentos_cas() const { return reintentos_cas.load(); }
+    long long get_retrocesos() const { return retrocesos.load(); }
+    std::string obtener_nombre() const { return "Mapa de Bits Atómico"; }
+
+    // Contar los bits ocupados y compararlos con el contador
+    // (solo tiene sentido sin hilos trabajando)
+    bool verificar_metricas() const;
+};
+
+#endif // MAPA_BITS_ATOMICO_H
@@ -0,0 +1,127 @@
+/*
+ * modelo_dispositivo.cpp
+ *
+ * Modelos de costo de I/O para el reloj simulado de `GestorDisco`.
+ * Reemplazan el sleep_for de antes: en vez de dormir, cada operación
+ * devuelve cuántos microsegundos habría tardado el dispositivo.
+ */
+
+#include "disk_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// ============================================================================
+// PARÁMETROS DEL HDD (disco de escritorio de 7200 RPM)
+//
+// - Una vuelta:        60 s / 7200 = 8.33 ms
+// - Pista:             512 KB (la transferencia lee una pista por vuelta
+//                      → ~63 MB/s sostenidos)
+// - Seek:              0.5 ms pista a pista, 15 ms de punta a punta.
+//                      Curva clásica: crece con la raíz de la distancia.
+// - Carrera completa:  PISTAS_DISCO pistas. El volumen simulado ocupa solo
+//                      las primeras pistas (es una partición chica de un
+//                      disco grande), así que los seeks son cortos y la
+//                      rotación domina, como en un disco real.
+// - Controlador:       50 µs por comando
+// ============================================================================
+
+namespace
+{
+
+const double US_POR_VUELTA = 60.0 * 1000000.0 / 7200.0;
+const IndiceBloque BYTES_POR_PISTA = 512 * 1024;
+const double SEEK_MINIMO_US = 500.0;
+const double SEEK_MAXIMO_US = 15000.0;
+const double PISTAS_DISCO = 200000.0;
+const double SOBRECARGA_HDD_US = 50.0;
+
+// SSD SATA típico
+const double LATENCIA_ESCRITURA_SSD_US = 40.0;
+const double LATENCIA_TRIM_SSD_US = 15.0;
+const double BYTES_POR_US_SSD = 500.0; // 500 MB/s
+
+} // namespace
+
+ModeloHDD::ModeloHDD(int tamanio_bloque)
+    : tamanio_bloque(tamanio_bloque),
+      bloques_por_pista(std::max<IndiceBloque>(1, BYTES_POR_PISTA / tamanio_bloque)),
+      pista_actual(0)
+{
+}
+
+double ModeloHDD::tiempo_seek_us(IndiceBloque distancia) const
+{
+    if (distancia == 0)
+        return 0.0;
+
+    double fraccion = std::min(1.0, distancia / PISTAS_DISCO);
+    return SEEK_MINIMO_US + (SEEK_MAXIMO_US - SEEK_MINIMO_US) * std::sqrt(fraccion);
+}
+
+/*
+ * ATENDER (HDD)
+ *
+ * EJEMPLO (bloques de 1 KB → 512 bloques por pista):
+ * cabezal en pista 0, allocar 8 bloques desde el 1300
+ * 1. Seek a la pista 2: 0.5 ms + curva
+ * 2. El plato sigue girando durante el seek; el sector 1300 % 512 = 276
+ *    está a 276/512 de vuelta. Se espera lo que falte hasta que pase
+ *    bajo el cabezal (entre 0 y 8.33 ms).
+ * 3. Transferir 8 KB a la velocidad de la pista
+ *
+ * LIBERACION solo reescribe el primer bloque del rango (metadatos);
+ * BUSQUEDA no toca el disco y solo paga el controlador.
+ */
+double ModeloHDD::atender(TipoOperacion tipo, IndiceBloque inicio,
+                         IndiceBloque num_bloques, double ahora_us)
+{
+    if (tipo == BUSQUEDA || inicio < 0)
+        return SOBRECARGA_HDD_US;
+
+    IndiceBloque bloques = (tipo == LIBERACION) ? 1 : num_bloques;
+    IndiceBloque pista = inicio / bloques_por_pista;
+
+    double costo = SOBRECARGA_HDD_US + tiempo_seek_us(std::llabs(pista - pista_actual));
+
+    // Ángulo del plato al terminar el seek vs. ángulo del sector pedido
+    double angulo_plato = std::fmod((ahora_us + costo) / US_POR_VUELTA, 1.0);
+    double angulo_sector = static_cast<double>(inicio % bloques_por_pista) / bloques_por_pista;
+    double espera = angulo_sector - angulo_plato;
+    if (espera < 0.0)
+        espera += 1.0;
+    costo += espera * US_POR_VUELTA;
+
+    // Transferencia: una pista por vuelta
+    costo += static_cast<double>(bloques) / bloques_por_pista * US_POR_VUELTA;
+
+    pista_actual = (inicio + bloques - 1) / bloques_por_pista;
+    return costo;
+}
+
+// ATENDER (SSD): latencia de comando + bytes / ancho de banda
+
+double ModeloSSD::atender(TipoOperacion tipo, IndiceBloque inicio,
+                         IndiceBloque num_bloques, double)
+{
+    if (tipo == BUSQUEDA || inicio < 0)
+        return 0.0;
+
+    if (tipo == LIBERACION)
+        return LATENCIA_TRIM_SSD_US; // TRIM: no transfiere datos
+
+    return LATENCIA_ESCRITURA_SSD_US +
+           static_cast<double>(num_bloques) * tamanio_bloque / BYTES_POR_US_SSD;
+}
+
+std::unique_ptr<ModeloDispositivo> crear_modelo_dispositivo(const std::string &nombre,
+                                                            int tamanio_bloque)
+{
+    if (nombre == "hdd")
+        return std::make_unique<ModeloHDD>(tamanio_bloque);
+    if (nombre == "ssd")
+        return std::make_unique<ModeloSSD>(tamanio_bloque);
+    if (nombre == "nulo")
+        return std::make_unique<ModeloNulo>();
+    return nullptr;
+}
@@ -0,0 +1,349 @@
+/*
+ * motor_io.cpp
+ *
+ * Motores de I/O asíncrono (ver motor_io.h): io_uring con las llamadas
+ * al sistema directas y un respaldo con un pool de hilos.
+ */
+
+#include "motor_io.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// io_uring solo si los encabezados del kernel lo traen; si no, el motor
+// queda no disponible y "auto" usa hilos
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define MOTOR_IO_URING 1
+#else
+#define MOTOR_IO_URING 0
+#endif
+
+// ============================================================================
+// MOTOR_IO (ranuras y buffers compartidos)
+// ============================================================================
+
+MotorIO::MotorIO(int fd, int tamanio_bloque, unsigned profundidad)
+    : fd(fd), tamanio_bloque(tamanio_bloque), profundidad(profundidad),
+      buffers(nullptr), bytes_por_ranura(0), etiquetas(profundidad, 0)
+{
+    bytes_por_ranura = static_cast<size_t>(BLOQUES_POR_PETICION) * tamanio_bloque;
+    bytes_por_ranura = (bytes_por_ranura + ALINEACION - 1) / ALINEACION * ALINEACION;
+
+    buffers = static_cast<unsigned char *>(std::aligned_alloc(ALINEACION, profundidad * bytes_por_ranura));
+    if (buffers == nullptr)
+    {
+        std::cerr << "Sin memoria para " << profundidad << " buffers de I/O\n";
+        this->profundidad = 0;
+        etiquetas.clear();
+        return;
+    }
+    std::memset(buffers, 0xA5, profundidad * bytes_por_ranura);
+
+    // Al revés: la primera en salir es la 0
+    for (unsigned r = profundidad; r > 0; r--)
+        ranuras_libres.push_back(r - 1);
+}
+
+MotorIO::~MotorIO()
+{
+    std::free(buffers);
+}
+
+int MotorIO::preparar_ranura(const PeticionIO &peticion)
+{
+    if (ranuras_libres.empty() || peticion.inicio < 0 ||
+        peticion.bloques <= 0 || peticion.bloques > BLOQUES_POR_PETICION)
+    {
+        return -1;
+    }
+
+    unsigned ranura = ranuras_libres.back();
+    ranuras_libres.pop_back();
+    etiquetas[ranura] = peticion.etiqueta;
+
+    if (peticion.escritura)
+    {
+        unsigned char *buffer = buffer_ranura(ranura);
+        for (IndiceBloque i = 0; i < peticion.bloques; i++)
+        {
+            uint64_t sello[2] = {static_cast<uint64_t>(peticion.inicio + i), peticion.etiqueta};
+            std::memcpy(buffer + i * tamanio_bloque, sello, std::min<size_t>(sizeof(sello), tamanio_bloque));
+        }
+    }
+    return static_cast<int>(ranura);
+}
+
+// ============================================================================
+// MOTOR_IO_URING
+//
+// io_uring_setup crea los anillos; se mapean tres regiones (SQ, CQ y el
+// arreglo de entradas SQE; SQ y CQ comparten mapa si el kernel tiene
+// IORING_FEAT_SINGLE_MMAP). Este proceso es el único productor de la SQ
+// y el único consumidor de la CQ: alcanza con publicar la cola de la SQ
+// con release y leer la de la CQ con acquire.
+// ============================================================================
+
+MotorIoUring::MotorIoUring(int fd, int tamanio_bloque, unsigned profundidad)
+    : MotorIO(fd, tamanio_bloque, profundidad), fd_anillo(-1),
+      mapa_sq(MAP_FAILED), bytes_mapa_sq(0), mapa_cq(MAP_FAILED), bytes_mapa_cq(0),
+      mapa_sqes(MAP_FAILED), bytes_mapa_sqes(0),
+      sq_cola(nullptr), sq_mascara(nullptr), sq_arreglo(nullptr), sqes(nullptr),
+      cq_cabeza(nullptr), cq_cola(nullptr), cq_mascara(nullptr), cqes(nullptr),
+      sin_enviar(0), iovecs(profundidad)
+{
+#if MOTOR_IO_URING
+    if (this->profundidad == 0)
+        return;
+
+    struct io_uring_params parametros;
+    std::memset(&parametros, 0, sizeof(parametros));
+    int anillo = static_cast<int>(syscall(__NR_io_uring_setup, profundidad, &parametros));
+    if (anillo < 0)
+        return; // Sin io_uring: disponible() da false
+
+    fd_anillo = anillo;
+    bytes_mapa_sq = parametros.sq_off.array + parametros.sq_entries * sizeof(unsigned);
+    bytes_mapa_cq = parametros.cq_off.cqes + parametros.cq_entries * sizeof(struct io_uring_cqe);
+    bool mapa_unico = (parametros.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (mapa_unico)
+        bytes_mapa_sq = bytes_mapa_cq = std::max(bytes_mapa_sq, bytes_mapa_cq);
+
+    mapa_sq = mmap(nullptr, bytes_mapa_sq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd_anillo, IORING_OFF_SQ_RING);
+    mapa_cq = mapa_unico ? mapa_sq
+                         : mmap(nullptr, bytes_mapa_cq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                fd_anillo, IORING_OFF_CQ_RING);
+    bytes_mapa_sqes = parametros.sq_entries * sizeof(struct io_uring_sqe);
+    mapa_sqes = mmap(nullptr, bytes_mapa_sqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     fd_anillo, IORING_OFF_SQES);
+
+    if (mapa_sq == MAP_FAILED || mapa_cq == MAP_FAILED || mapa_sqes == MAP_FAILED)
+    {
+        std::cerr << "io_uring: no se pudieron mapear los anillos: " << std::strerror(errno) << "\n";
+        liberar_anillo();
+        return;
+    }
+
+    char *sq = static_cast<char *>(mapa_sq);
+    char *cq = static_cast<char *>(mapa_cq);
+    sq_cola = reinterpret_cast<unsigned *>(sq + parametros.sq_off.tail);
+    sq_mascara = reinterpret_cast<unsigned *>(sq + parametros.sq_off.ring_mask);
+    sq_arreglo = reinterpret_cast<unsigned *>(sq + parametros.sq_off.array);
+    sqes = mapa_sqes;
+    cq_cabeza = reinterpret_cast<unsigned *>(cq + parametros.cq_off.head);
+    cq_cola = reinterpret_cast<unsigned *>(cq + parametros.cq_off.tail);
+    cq_mascara = reinterpret_cast<unsigned *>(cq + parametros.cq_off.ring_mask);
+    cqes = cq + parametros.cq_off.cqes;
+#endif
+}
+
+MotorIoUring::~MotorIoUring()
+{
+    // El kernel todavía puede escribir en los buffers de lo que está en
+    // vuelo: esperarlo antes de liberarlos
+    std::vector<CompletadaIO> descarte;
+    while (disponible() && get_en_vuelo() > 0)
+    {
+        if (cosechar(descarte, get_en_vuelo()) == 0)
+            break;
+    }
+    liberar_anillo();
+}
+
+void MotorIoUring::liberar_anillo()
+{
+    if (mapa_sqes != MAP_FAILED)
+        munmap(mapa_sqes, bytes_mapa_sqes);
+    if (mapa_cq != MAP_FAILED && mapa_cq != mapa_sq)
+        munmap(mapa_cq, bytes_mapa_cq);
+    if (mapa_sq != MAP_FAILED)
+        munmap(mapa_sq, bytes_mapa_sq);
+    mapa_sq = mapa_cq = mapa_sqes = MAP_FAILED;
+
+    if (fd_anillo >= 0)
+        close(fd_anillo);
+    fd_anillo = -1;
+}
+
+bool MotorIoUring::enviar(const PeticionIO &peticion)
+{
+#if MOTOR_IO_URING
+    if (!disponible())
+        return false;
+
+    int ranura = preparar_ranura(peticion);
+    if (ranura < 0)
+        return false;
+
+    iovecs[ranura].iov_base = buffer_ranura(ranura);
+    iovecs[ranura].iov_len = static_cast<size_t>(peticion.bloques) * tamanio_bloque;
+
+    // Hay tantas entradas como ranuras: la SQ nunca está llena acá
+    unsigned cola = *sq_cola;
+    unsigned indice = cola & *sq_mascara;
+    struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(sqes) + indice;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = peticion.escritura ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&iovecs[ranura]);
+    sqe->len = 1;
+    sqe->off = static_cast<uint64_t>(peticion.inicio) * tamanio_bloque;
+    sqe->user_data = static_cast<uint64_t>(ranura);
+
+    sq_arreglo[indice] = indice;
+    __atomic_store_n(sq_cola, cola + 1, __ATOMIC_RELEASE);
+    sin_enviar++;
+    return true;
+#else
+    (void)peticion;
+    return false;
+#endif
+}
+
+size_t MotorIoUring::cosechar(std::vector<CompletadaIO> &salida, size_t minimo)
+{
+#if MOTOR_IO_URING
+    if (!disponible())
+        return 0;
+
+    minimo = std::min<size_t>(minimo, get_en_vuelo());
+    size_t agregadas = 0;
+
+    while (true)
+    {
+        // Vaciar la CQ
+        unsigned cabeza = *cq_cabeza;
+        unsigned cola = __atomic_load_n(cq_cola, __ATOMIC_ACQUIRE);
+        for (; cabeza != cola; cabeza++)
+        {
+            const struct io_uring_cqe *cqe = static_cast<const struct io_uring_cqe *>(cqes) + (cabeza & *cq_mascara);
+            unsigned ranura = static_cast<unsigned>(cqe->user_data);
+            salida.push_back({etiquetas[ranura], cqe->res});
+            ranuras_libres.push_back(ranura);
+            agregadas++;
+        }
+        __atomic_store_n(cq_cabeza, cabeza, __ATOMIC_RELEASE);
+
+        if (agregadas >= minimo && sin_enviar == 0)
+            return agregadas;
+
+        // Mandar lo acumulado y (si falta) esperar el resto en la misma llamada
+        unsigned esperar = static_cast<unsigned>(minimo > agregadas ? minimo - agregadas : 0);
+        unsigned banderas = esperar > 0 ? IORING_ENTER_GETEVENTS : 0;
+        long enviadas = syscall(__NR_io_uring_enter, fd_anillo, sin_enviar, esperar, banderas, nullptr, 0);
+        if (enviadas < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                continue;
+            std::cerr << "io_uring_enter: " << std::strerror(errno) << "\n";
+            return agregadas;
+        }
+        sin_enviar -= static_cast<unsigned>(enviadas);
+    }
+#else
+    (void)salida;
+    (void)minimo;
+    return 0;
+#endif
+}
+
+// ============================================================================
+// MOTOR_HILOS
+//
+// Cada petición es una tarea del pool: pwrite / pread bloqueante sobre
+// el buffer de su ranura y la completada a la cola compartida. Las
+// ranuras y etiquetas solo las toca el hilo que envía y cosecha.
+// ============================================================================
+
+MotorHilos::MotorHilos(int fd, int tamanio_bloque, unsigned profundidad)
+    : MotorIO(fd, tamanio_bloque, profundidad),
+      pool(profundidad == 0 ? 1 : (profundidad < HILOS_MAXIMOS ? profundidad : HILOS_MAXIMOS))
+{
+}
+
+MotorHilos::~MotorHilos()
+{
+}
+
+void MotorHilos::atender(unsigned ranura, PeticionIO peticion)
+{
+    char *p = reinterpret_cast<char *>(buffer_ranura(ranura));
+    size_t largo = static_cast<size_t>(peticion.bloques) * tamanio_bloque;
+    off_t desplazamiento = static_cast<off_t>(peticion.inicio) * tamanio_bloque;
+    int64_t resultado = 0;
+
+    while (static_cast<size_t>(resultado) < largo)
+    {
+        ssize_t hechos = peticion.escritura
+                             ? pwrite(fd, p + resultado, largo - resultado, desplazamiento + resultado)
+                             : pread(fd, p + resultado, largo - resultado, desplazamiento + resultado);
+        if (hechos < 0 && errno == EINTR)
+            continue;
+        if (hechos < 0)
+        {
+            resultado = -errno;
+            break;
+        }
+        if (hechos == 0)
+            break; // Lectura más allá del final
+        resultado += hechos;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        completadas.push_back({ranura, resultado});
+    }
+    hay_completadas.notify_one();
+}
+
+bool MotorHilos::enviar(const PeticionIO &peticion)
+{
+    int ranura = preparar_ranura(peticion);
+    if (ranura < 0)
+        return false;
+
+    pool.enviar([this, ranura, peticion]
+                { atender(static_cast<unsigned>(ranura), peticion); });
+    return true;
+}
+
+size_t MotorHilos::cosechar(std::vector<CompletadaIO> &salida, size_t minimo)
+{
+    minimo = std::min<size_t>(minimo, get_en_vuelo());
+
+    std::unique_lock<std::mutex> lock(mutex);
+    hay_completadas.wait(lock, [&]
+                         { return completadas.size() >= minimo; });
+
+    for (const CompletadaIO &completada : completadas)
+    {
+        unsigned ranura = static_cast<unsigned>(completada.etiqueta);
+        salida.push_back({etiquetas[ranura], completada.resultado});
+        ranuras_libres.push_back(ranura);
+    }
+    size_t agregadas = completadas.size();
+    completadas.clear();
+    return agregadas;
+}
+
+std::unique_ptr<MotorIO> crear_motor_io(const std::string &nombre, int fd, int tamanio_bloque,
+                                        unsigned profundidad)
+{
+    if (nombre == "uring" || nombre == "auto")
+    {
+        auto motor = std::make_unique<MotorIoUring>(fd, tamanio_bloque, profundidad);
+        if (motor->disponible())
+            return motor;
+        if (nombre == "uring")
+            return nullptr;
+    }
+    if (nombre == "hilos" || nombre == "auto")
+        return std::make_unique<MotorHilos>(fd, tamanio_bloque, profundidad);
+    return nullptr;
+}
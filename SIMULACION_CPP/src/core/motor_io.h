@@ -0,0 +1,179 @@
+/*
+ * motor_io.h
+ *
+ * Motor de I/O asíncrono sobre un archivo imagen (imagen_disco.h):
+ * mantiene hasta `profundidad` peticiones de bloques en vuelo a la vez,
+ * en vez de escribir una extensión y esperar antes de la siguiente.
+ *
+ * USO:
+ *   auto motor = crear_motor_io("auto", imagen.get_fd(), tamanio_bloque, 32);
+ *   motor->enviar({inicio, bloques, true, etiqueta}); // false si está lleno
+ *   motor->cosechar(completadas, 1);                  // espera >= 1
+ *
+ * Las peticiones terminan en cualquier orden: cada completada devuelve
+ * la etiqueta de su petición y los bytes transferidos (o -errno).
+ *
+ * IMPLEMENTACIONES:
+ * - MotorIoUring: io_uring del kernel (5.1+) con las llamadas al sistema
+ *   directas, sin liburing. enviar() solo llena una entrada de la cola
+ *   de envío (SQ); cosechar() manda todas las acumuladas y espera
+ *   completadas (CQ) en UNA llamada io_uring_enter:
+ *
+ *     enviar ×N ──► SQ [e1 e2 ... eN] ──io_uring_enter──► kernel
+ *     cosechar  ◄── CQ [c3 c1 ...]    ◄──────────────────┘
+ *
+ * - MotorHilos: respaldo portable. Un PoolHilos de hasta HILOS_MAXIMOS
+ *   hilos que hacen pwrite / pread bloqueantes; cada uno deja su
+ *   completada en una cola con mutex.
+ *
+ * Cada ranura en vuelo tiene su propio buffer alineado a 4096 (sirve con
+ * O_DIRECT) de BLOQUES_POR_PETICION bloques: las extensiones más largas
+ * las parte quien envía. Las escrituras sellan cada bloque con su número,
+ * como ImagenDisco.
+ */
+
+#ifndef MOTOR_IO_H
+#define MOTOR_IO_H
+
+#include "disk_manager.h"
+#include "pool_hilos.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+struct PeticionIO
+{
+    IndiceBloque inicio;
+    IndiceBloque bloques; // <= BLOQUES_POR_PETICION
+    bool escritura;       // false = lectura
+    uint64_t etiqueta;    // Libre para quien envía; vuelve en la completada
+};
+
+struct CompletadaIO
+{
+    uint64_t etiqueta;
+    int64_t resultado; // Bytes transferidos, o -errno
+};
+
+// Clase abstracta: MotorIO
+
+class MotorIO
+{
+protected:
+    int fd;
+    int tamanio_bloque;
+    unsigned profundidad;
+
+    // Una ranura por petición en vuelo
+    unsigned char *buffers; // profundidad × bytes_por_ranura, alineado
+    size_t bytes_por_ranura;
+    std::vector<unsigned> ranuras_libres;
+    std::vector<uint64_t> etiquetas; // Etiqueta de la petición en cada ranura
+
+    // Tomar una ranura y dejar su buffer listo (sellado si es escritura)
+    // Retorna: la ranura, o -1 si están todas en vuelo
+    int preparar_ranura(const PeticionIO &peticion);
+    unsigned char *buffer_ranura(unsigned ranura) const { return buffers + ranura * bytes_por_ranura; }
+
+public:
+    static const int BLOQUES_POR_PETICION = 256;
+    static const size_t ALINEACION = 4096;
+
+    MotorIO(int fd, int tamanio_bloque, unsigned profundidad);
+    virtual ~MotorIO();
+
+    MotorIO(const MotorIO &) = delete;
+    MotorIO &operator=(const MotorIO &) = delete;
+
+    // Poner una petición en vuelo (io_uring: recién sale en cosechar)
+    // Retorna: false si ya hay `profundidad` en vuelo o la petición no es válida
+    virtual bool enviar(const PeticionIO &peticion) = 0;
+
+    // Esperar al menos `minimo` completadas (0 = no esperar; nunca más
+    // de las que hay en vuelo) y agregar a `salida` todas las disponibles
+    // Retorna: cuántas se agregaron (menos que `minimo` solo si el motor
+    // falló; el motivo sale por cerr)
+    virtual size_t cosechar(std::vector<CompletadaIO> &salida, size_t minimo) = 0;
+
+    virtual std::string nombre() const = 0;
+
+    unsigned get_profundidad() const { return profundidad; }
+    unsigned get_en_vuelo() const { return profundidad - static_cast<unsigned>(ranuras_libres.size()); }
+};
+
+// Clase: MotorIoUring
+
+class MotorIoUring : public MotorIO
+{
+private:
+    int fd_anillo;
+
+    // Anillos mapeados del kernel
+    void *mapa_sq;
+    size_t bytes_mapa_sq;
+    void *mapa_cq;
+    size_t bytes_mapa_cq;
+    void *mapa_sqes;
+    size_t bytes_mapa_sqes;
+
+    // Punteros dentro de los mapas (ver io_uring_setup(2))
+    unsigned *sq_cola;
+    unsigned *sq_mascara;
+    unsigned *sq_arreglo;
+    void *sqes;
+    unsigned *cq_cabeza;
+    unsigned *cq_cola;
+    unsigned *cq_mascara;
+    void *cqes;
+
+    unsigned sin_enviar; // Entradas llenadas que el kernel todavía no vio
+    std::vector<struct iovec> iovecs; // Uno por ranura
+
+    void liberar_anillo();
+
+public:
+    MotorIoUring(int fd, int tamanio_bloque, unsigned profundidad);
+    ~MotorIoUring();
+
+    // false si el kernel no tiene io_uring (o está deshabilitado)
+    bool disponible() const { return fd_anillo >= 0; }
+
+    bool enviar(const PeticionIO &peticion) override;
+    size_t cosechar(std::vector<CompletadaIO> &salida, size_t minimo) override;
+    std::string nombre() const override { return "io_uring"; }
+};
+
+// Clase: MotorHilos
+
+class MotorHilos : public MotorIO
+{
+private:
+    std::mutex mutex;
+    std::condition_variable hay_completadas;
+    std::vector<CompletadaIO> completadas; // Ranura en `etiqueta` hasta cosechar
+    PoolHilos pool; // Último miembro: se une antes de destruir lo demás
+
+    void atender(unsigned ranura, PeticionIO peticion);
+
+public:
+    static const unsigned HILOS_MAXIMOS = 32;
+
+    MotorHilos(int fd, int tamanio_bloque, unsigned profundidad);
+    ~MotorHilos();
+
+    bool enviar(const PeticionIO &peticion) override;
+    size_t cosechar(std::vector<CompletadaIO> &salida, size_t minimo) override;
+    std::string nombre() const override { return "hilos"; }
+};
+
+// Crear un motor por nombre: "uring", "hilos" o "auto" (io_uring si el
+// kernel lo tiene, si no hilos)
+// Retorna: nullptr si el nombre no se reconoce o "uring" no está disponible
+std::unique_ptr<MotorIO> crear_motor_io(const std::string &nombre, int fd, int tamanio_bloque,
+                                        unsigned profundidad);
+
+#endif // MOTOR_IO_H
@@ -0,0 +1,48 @@
+/*
+ * pool_hilos.cpp
+ *
+ * Implementación del pool fijo de hilos.
+ */
+
+#include "pool_hilos.h"
+#include <algorithm>
+
+PoolHilos::PoolHilos(size_t num_hilos)
+    : detener(false)
+{
+    num_hilos = std::max<size_t>(1, num_hilos);
+    for (size_t i = 0; i < num_hilos; i++)
+        hilos.emplace_back(&PoolHilos::trabajar, this);
+}
+
+PoolHilos::~PoolHilos()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    hay_tarea.notify_all();
+    for (auto &hilo : hilos)
+        hilo.join();
+}
+
+// trabajar: tomar la próxima tarea y ejecutarla sin el mutex
+// (al detener se vacía la cola antes de salir)
+
+void PoolHilos::trabajar()
+{
+    while (true)
+    {
+        std::function<void()> tarea;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hay_tarea.wait(lock, [this]
+                           { return detener || !tareas.empty(); });
+            if (tareas.empty())
+                return;
+            tarea = std::move(tareas.front());
+            tareas.pop_front();
+        }
+        tarea();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * pool_hilos.h
+ *
+ * Pool fijo de hilos con una cola de tareas.
+ *
+ * USO:
+ *   PoolHilos pool(4);
+ *   std::future<int> f = pool.enviar([] { return 42; });
+ *   f.get(); // espera esa tarea (las excepciones viajan en el future)
+ *
+ * Las tareas se toman en orden de envío, pero terminan en cualquier
+ * orden: quien necesite el orden original lo arma con los futures.
+ */
+
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class PoolHilos
+{
+private:
+    std::mutex mutex;
+    std::condition_variable hay_tarea;
+    std::deque<std::function<void()>> tareas;
+    bool detener;
+    std::vector<std::thread> hilos; // Último miembro: arrancan con lo demás listo
+
+    void trabajar();
+
+public:
+    explicit PoolHilos(size_t num_hilos);
+    ~PoolHilos(); // Termina las tareas pendientes y une los hilos
+
+    PoolHilos(const PoolHilos &) = delete;
+    PoolHilos &operator=(const PoolHilos &) = delete;
+
+    size_t get_num_hilos() const { return hilos.size(); }
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> enviar(F &&tarea);
+};
+
+template <typename F>
+std::future<std::invoke_result_t<F>> PoolHilos::enviar(F &&tarea)
+{
+    typedef std::invoke_result_t<F> Resultado;
+
+    // packaged_task no se copia y std::function exige copiable:
+    // se comparte por puntero
+    auto empaquetada = std::make_shared<std::packaged_task<Resultado()>>(std::forward<F>(tarea));
+    std::future<Resultado> futuro = empaquetada->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tareas.push_back([empaquetada]
+                         { (*empaquetada)(); });
+    }
+    hay_tarea.notify_one();
+    return futuro;
+}
+
+#endif // POOL_HILOS_H
@@ -0,0 +1,185 @@
+/*
+ * pool_nodos.h
+ *
+ * Arena (slab allocator) de nodos para las listas enlazadas.
+ *
+ * CÓMO FUNCIONA:
+ * Los nodos se reservan por losas: bloques contiguos de memoria con
+ * espacio para muchos nodos. Un nodo liberado no vuelve al heap: su
+ * propia memoria se reutiliza como enlace de una lista de libres
+ * (lista intrusiva), y el próximo `crear` lo toma de ahí.
+ *
+ *  losa 0: [n0][n1][n2][n3]...     libres → n2 → n0 → NULL
+ *  losa 1: [n256][n257]...
+ *
+ * VENTAJAS:
+ * - Crear/destruir en O(1) sin llamar a new/delete
+ * - Nodos contiguos: menos fallos de caché al recorrer la lista
+ * - reiniciar() descarta todos los nodos en O(1) y conserva las losas
+ * - absorber() junta arenas armadas en hilos distintos sin copiar nodos
+ *
+ * RESTRICCIÓN:
+ * T debe ser trivialmente destructible (reiniciar no llama destructores).
+ */
+
+#ifndef POOL_NODOS_H
+#define POOL_NODOS_H
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include <algorithm>
+
+template <typename T>
+class PoolNodos
+{
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "PoolNodos requiere nodos trivialmente destructibles");
+
+private:
+    // Una ranura guarda un nodo vivo o, si está libre, el enlace al siguiente libre
+    union Ranura
+    {
+        Ranura *siguiente_libre;
+        alignas(T) unsigned char datos[sizeof(T)];
+    };
+
+    static constexpr size_t RANURAS_LOSA_INICIAL = 256;
+    static constexpr size_t RANURAS_LOSA_MAXIMA = 65536;
+
+    std::vector<std::unique_ptr<Ranura[]>> losas;
+    std::vector<size_t> capacidades; // Ranuras de cada losa
+    size_t losa_actual;              // Losa de la que se toman ranuras nuevas
+    size_t usadas_en_losa;           // Ranuras ya entregadas de losa_actual
+    Ranura *libres;                  // Lista intrusiva de ranuras devueltas
+    size_t vivos;                    // Nodos entregados y no devueltos
+
+    Ranura *nueva_ranura()
+    {
+        if (libres != nullptr)
+        {
+            Ranura *r = libres;
+            libres = r->siguiente_libre;
+            return r;
+        }
+
+        // Pasar a la siguiente losa (reservándola si hace falta)
+        if (losas.empty() || usadas_en_losa == capacidades[losa_actual])
+        {
+            if (!losas.empty())
+                losa_actual++;
+            if (losa_actual == losas.size())
+            {
+                size_t capacidad = losas.empty()
+                                       ? RANURAS_LOSA_INICIAL
+                                       : std::min(capacidades.back() * 2, RANURAS_LOSA_MAXIMA);
+                losas.emplace_back(new Ranura[capacidad]);
+                capacidades.push_back(capacidad);
+            }
+            usadas_en_losa = 0;
+        }
+
+        return &losas[losa_actual][usadas_en_losa++];
+    }
+
+public:
+    PoolNodos() : losa_actual(0), usadas_en_losa(0), libres(nullptr), vivos(0) {}
+
+    // No copiable: los punteros entregados pertenecen a esta arena
+    PoolNodos(const PoolNodos &) = delete;
+    PoolNodos &operator=(const PoolNodos &) = delete;
+
+    template <typename... Args>
+    T *crear(Args &&...args)
+    {
+        Ranura *r = nueva_ranura();
+        vivos++;
+        return new (r->datos) T(std::forward<Args>(args)...);
+    }
+
+    void destruir(T *nodo)
+    {
+        if (nodo == nullptr)
+            return;
+        Ranura *r = reinterpret_cast<Ranura *>(nodo);
+        r->siguiente_libre = libres;
+        libres = r;
+        vivos--;
+    }
+
+    // Descartar todos los nodos en O(1); las losas quedan para reutilizarse
+    void reiniciar()
+    {
+        losa_actual = 0;
+        usadas_en_losa = 0;
+        libres = nullptr;
+        vivos = 0;
+    }
+
+    // Descartar todos los nodos y devolver las losas al heap
+    void vaciar()
+    {
+        losas.clear();
+        capacidades.clear();
+        reiniciar();
+    }
+
+    // Pasar a esta arena las losas de `otra` con sus nodos vivos: los
+    // punteros siguen valiendo y desde ahora los libera esta arena. Las
+    // ranuras que `otra` no llegó a entregar van a la lista de libres.
+    // `otra` queda vacía.
+    void absorber(PoolNodos &otra)
+    {
+        bool estaba_vacia = losas.empty();
+
+        for (size_t i = 0; i < otra.losas.size(); i++)
+        {
+            size_t entregadas = (i < otra.losa_actual)    ? otra.capacidades[i]
+                                : (i == otra.losa_actual) ? otra.usadas_en_losa
+                                                          : 0;
+            for (size_t j = entregadas; j < otra.capacidades[i]; j++)
+            {
+                Ranura *r = &otra.losas[i][j];
+                r->siguiente_libre = libres;
+                libres = r;
+            }
+
+            // Va antes de la losa actual: cuenta como ya repartida
+            losas.insert(losas.begin() + losa_actual, std::move(otra.losas[i]));
+            capacidades.insert(capacidades.begin() + losa_actual, otra.capacidades[i]);
+            losa_actual++;
+        }
+
+        if (estaba_vacia && !losas.empty())
+        {
+            losa_actual = losas.size() - 1;
+            usadas_en_losa = capacidades[losa_actual];
+        }
+
+        while (otra.libres != nullptr)
+        {
+            Ranura *r = otra.libres;
+            otra.libres = r->siguiente_libre;
+            r->siguiente_libre = libres;
+            libres = r;
+        }
+
+        vivos += otra.vivos;
+        otra.vaciar();
+    }
+
+    size_t nodos_vivos() const { return vivos; }
+
+    size_t bytes_reservados() const
+    {
+        size_t total = 0;
+        for (size_t capacidad : capacidades)
+            total += capacidad * sizeof(Ranura);
+        return total;
+    }
+};
+
+#endif // POOL_NODOS_H
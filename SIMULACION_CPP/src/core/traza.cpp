@@ -0,0 +1,259 @@
+/*
+ * traza.cpp
+ *
+ * Grabación, lectura y reproducción de trazas binarias.
+ */
+
+#include "traza.h"
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+static const char MAGIA_TRAZA[4] = {'T', 'R', 'Z', 'A'};
+static const uint32_t VERSION_TRAZA = 1;
+
+// Enteros de ancho fijo en little-endian, byte a byte (independiente de
+// la arquitectura)
+
+template <typename T>
+static void escribir_fijo(std::ostream &salida, T valor)
+{
+    uint64_t v = static_cast<uint64_t>(valor);
+    for (size_t i = 0; i < sizeof(T); i++)
+        salida.put(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+template <typename T>
+static bool leer_fijo(std::istream &entrada, T &valor)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        int c = entrada.get();
+        if (c == EOF)
+            return false;
+        v |= static_cast<uint64_t>(c) << (8 * i);
+    }
+    valor = static_cast<T>(v);
+    return true;
+}
+
+// zigzag: 0, -1, 1, -2, ... → 0, 1, 2, 3, ... (el -1 de una allocación
+// fallida ocupa un byte)
+
+static uint64_t a_zigzag(int64_t valor)
+{
+    return (static_cast<uint64_t>(valor) << 1) ^ static_cast<uint64_t>(valor >> 63);
+}
+
+static int64_t desde_zigzag(uint64_t valor)
+{
+    return static_cast<int64_t>(valor >> 1) ^ -static_cast<int64_t>(valor & 1);
+}
+
+static bool leer_varint(std::istream &entrada, uint64_t &valor)
+{
+    valor = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7)
+    {
+        int c = entrada.get();
+        if (c == EOF)
+            return false;
+        valor |= static_cast<uint64_t>(c & 0x7F) << desplazamiento;
+        if ((c & 0x80) == 0)
+            return true;
+    }
+    return false; // Más de 10 bytes: corrupto
+}
+
+// ============================================================================
+// GRABADOR
+// ============================================================================
+
+GrabadorTraza::GrabadorTraza(const std::string &ruta, IndiceBloque total_bloques, int tamanio_bloque)
+    : archivo(ruta, std::ios::binary | std::ios::trunc),
+      comienzo(std::chrono::steady_clock::now()),
+      ultima_marca_ns(0),
+      registros(0)
+{
+    if (!archivo.is_open())
+    {
+        std::cerr << "Error al abrir archivo de traza: " << ruta << "\n";
+        return;
+    }
+
+    archivo.write(MAGIA_TRAZA, sizeof(MAGIA_TRAZA));
+    escribir_fijo<uint32_t>(archivo, VERSION_TRAZA);
+    escribir_fijo<int64_t>(archivo, total_bloques);
+    escribir_fijo<uint32_t>(archivo, static_cast<uint32_t>(tamanio_bloque));
+    escribir_fijo<uint32_t>(archivo, 0);
+}
+
+void GrabadorTraza::escribir_varint(uint64_t valor)
+{
+    while (valor >= 0x80)
+    {
+        archivo.put(static_cast<char>((valor & 0x7F) | 0x80));
+        valor >>= 7;
+    }
+    archivo.put(static_cast<char>(valor));
+}
+
+void GrabadorTraza::grabar(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque tamanio)
+{
+    auto ahora = std::chrono::steady_clock::now();
+    uint64_t marca = std::chrono::duration_cast<std::chrono::nanoseconds>(ahora - comienzo).count();
+    grabar(tipo, inicio, tamanio, marca);
+}
+
+void GrabadorTraza::grabar(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque tamanio, uint64_t marca_ns)
+{
+    if (!archivo.is_open() || !archivo.good())
+        return; // Tras un error no se sigue escribiendo; cerrar() lo informa
+
+    // Las marcas no retroceden: delta siempre >= 0
+    if (marca_ns < ultima_marca_ns)
+        marca_ns = ultima_marca_ns;
+
+    archivo.put(static_cast<char>(tipo));
+    escribir_varint(marca_ns - ultima_marca_ns);
+    if (tipo != BUSQUEDA)
+    {
+        escribir_varint(static_cast<uint64_t>(tamanio));
+        escribir_varint(a_zigzag(inicio));
+    }
+
+    ultima_marca_ns = marca_ns;
+    registros++;
+}
+
+bool GrabadorTraza::cerrar()
+{
+    if (!archivo.is_open())
+        return false;
+
+    archivo.flush();
+    bool ok = archivo.good();
+    archivo.close();
+    return ok && archivo.good();
+}
+
+// ============================================================================
+// LECTURA
+// ============================================================================
+
+bool leer_traza(const std::string &ruta, CabeceraTraza &cabecera, std::vector<RegistroTraza> &registros)
+{
+    std::ifstream archivo(ruta, std::ios::binary);
+    if (!archivo.is_open())
+    {
+        std::cerr << "Error al abrir archivo de traza: " << ruta << "\n";
+        return false;
+    }
+
+    char magia[sizeof(MAGIA_TRAZA)];
+    uint32_t version = 0;
+    uint32_t tamanio_bloque = 0;
+    uint32_t reservado = 0;
+    if (!archivo.read(magia, sizeof(magia)) || std::memcmp(magia, MAGIA_TRAZA, sizeof(magia)) != 0 ||
+        !leer_fijo(archivo, version) || version != VERSION_TRAZA ||
+        !leer_fijo(archivo, cabecera.total_bloques) ||
+        !leer_fijo(archivo, tamanio_bloque) || !leer_fijo(archivo, reservado))
+    {
+        std::cerr << "Traza inválida (cabecera): " << ruta << "\n";
+        return false;
+    }
+    cabecera.tamanio_bloque = static_cast<int>(tamanio_bloque);
+
+    registros.clear();
+    uint64_t marca = 0;
+    int tipo;
+    while ((tipo = archivo.get()) != EOF)
+    {
+        RegistroTraza registro;
+        uint64_t delta = 0;
+        uint64_t tamanio = 0;
+        uint64_t inicio = a_zigzag(-1);
+
+        bool completo = tipo <= BUSQUEDA && leer_varint(archivo, delta);
+        if (completo && tipo != BUSQUEDA)
+            completo = leer_varint(archivo, tamanio) && leer_varint(archivo, inicio);
+        if (!completo)
+        {
+            std::cerr << "Traza inválida (registro " << registros.size() << "): " << ruta << "\n";
+            return false;
+        }
+
+        marca += delta;
+        registro.tipo = static_cast<TipoOperacion>(tipo);
+        registro.inicio = desde_zigzag(inicio);
+        registro.tamanio = static_cast<IndiceBloque>(tamanio);
+        registro.marca_ns = marca;
+        registros.push_back(registro);
+    }
+
+    return true;
+}
+
+// ============================================================================
+// REPRODUCIR_TRAZA
+//
+// `reubicacion`: inicio grabado → inicio real, solo para las extensiones
+// vivas que este gestor puso en otro lugar (o no pudo allocar: -1).
+// Una liberación cuyo inicio no está en la tabla se aplica tal cual
+// (extensiones del estado inicial, o que coincidieron con la grabación).
+// ============================================================================
+
+ResultadoReproduccion reproducir_traza(GestorDisco &gestor, const std::vector<RegistroTraza> &registros)
+{
+    ResultadoReproduccion resultado;
+    std::unordered_map<IndiceBloque, IndiceBloque> reubicacion;
+
+    auto comienzo = std::chrono::steady_clock::now();
+
+    for (const RegistroTraza &registro : registros)
+    {
+        switch (registro.tipo)
+        {
+        case ALLOCACION:
+        {
+            IndiceBloque real = gestor.allocar(registro.tamanio);
+            if (real == -1)
+                resultado.fallos_allocacion++;
+
+            if (real != registro.inicio)
+            {
+                resultado.reubicadas++;
+                if (registro.inicio != -1)
+                    reubicacion[registro.inicio] = real;
+            }
+            else if (registro.inicio != -1)
+            {
+                reubicacion.erase(registro.inicio);
+            }
+            break;
+        }
+        case LIBERACION:
+        {
+            IndiceBloque inicio = registro.inicio;
+            auto it = reubicacion.find(inicio);
+            if (it != reubicacion.end())
+            {
+                inicio = it->second;
+                reubicacion.erase(it);
+            }
+            if (inicio != -1)
+                gestor.liberar(inicio, registro.tamanio);
+            break;
+        }
+        case BUSQUEDA:
+            gestor.buscar_bloque_mas_grande();
+            break;
+        }
+        resultado.operaciones++;
+    }
+
+    auto fin = std::chrono::steady_clock::now();
+    resultado.cpu_ms = std::chrono::duration<double, std::milli>(fin - comienzo).count();
+    return resultado;
+}
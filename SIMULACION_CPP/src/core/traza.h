@@ -0,0 +1,99 @@
+/*
+ * traza.h
+ *
+ * Trazas de operaciones: grabar lo que se le pidió a un gestor y
+ * reproducirlo después, tal cual, sobre cualquier otra estructura.
+ *
+ * FORMATO BINARIO (little-endian):
+ *
+ *  Cabecera, 24 bytes:
+ *   "TRZA" | versión u32 | total_bloques i64 | tamanio_bloque u32 | 0 u32
+ *
+ *  Un registro por operación, de largo variable:
+ *   tipo      1 byte   (TipoOperacion: 0 allocación, 1 liberación, 2 búsqueda)
+ *   delta     varint   ns desde el registro anterior
+ *   tamaño    varint   (no en búsqueda)
+ *   inicio    varint zigzag: allocación → posición obtenida (-1 si
+ *             falló); liberación → posición liberada (no en búsqueda)
+ *
+ *  varint = 7 bits por byte, el bit alto indica "sigue". Una operación
+ *  típica ocupa 5-8 bytes en vez de 25.
+ *
+ * REPRODUCCIÓN:
+ * Las operaciones se decodifican antes y se entregan al gestor sin
+ * esperas (las marcas de tiempo solo sirven para comparar duraciones).
+ * Si el gestor deja una allocación en otra posición que la grabada, las
+ * liberaciones posteriores de esa extensión se traducen a la posición
+ * real: todas las estructuras reciben la misma secuencia LÓGICA.
+ */
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include "disk_manager.h"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct CabeceraTraza
+{
+    IndiceBloque total_bloques;
+    int tamanio_bloque;
+};
+
+struct RegistroTraza
+{
+    TipoOperacion tipo;
+    IndiceBloque inicio;  // Resultado de la allocación o bloque liberado
+    IndiceBloque tamanio;
+    uint64_t marca_ns;    // Desde el comienzo de la grabación
+};
+
+// GrabadorTraza: escribe registros a medida que ocurren
+class GrabadorTraza
+{
+private:
+    std::ofstream archivo;
+    std::chrono::steady_clock::time_point comienzo;
+    uint64_t ultima_marca_ns;
+    long long registros;
+
+    void escribir_varint(uint64_t valor);
+
+public:
+    GrabadorTraza(const std::string &ruta, IndiceBloque total_bloques, int tamanio_bloque);
+
+    bool abierto() const { return archivo.is_open(); }
+    long long get_registros() const { return registros; }
+
+    // Sellar con el reloj real (ns desde que se creó el grabador)
+    void grabar(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque tamanio);
+
+    // Sellar con una marca dada (trazas sintéticas o importadas)
+    void grabar(TipoOperacion tipo, IndiceBloque inicio, IndiceBloque tamanio, uint64_t marca_ns);
+
+    // Vaciar el buffer y cerrar el archivo
+    // Retorna: false si alguna escritura falló (disco lleno, EIO): la
+    // traza quedó cortada
+    bool cerrar();
+};
+
+// Leer una traza completa
+// Retorna: false (con mensaje en cerr) si no se puede abrir o está corrupta
+bool leer_traza(const std::string &ruta, CabeceraTraza &cabecera, std::vector<RegistroTraza> &registros);
+
+// Resultado de reproducir una traza sobre un gestor
+struct ResultadoReproduccion
+{
+    long long operaciones = 0;
+    long long fallos_allocacion = 0; // Allocaciones que devolvieron -1
+    long long reubicadas = 0;        // Allocaciones en otra posición que la grabada
+    double cpu_ms = 0.0;             // Bucle de reproducción completo
+};
+
+// Entregar los registros al gestor lo más rápido posible, en orden
+ResultadoReproduccion reproducir_traza(GestorDisco &gestor, const std::vector<RegistroTraza> &registros);
+
+#endif // TRAZA_H
@@ -0,0 +1,35 @@
+/*
+ * carga_trabajo.cpp
+ *
+ * Utilidades para preparar el estado inicial de los experimentos.
+ */
+
+#include "experimentos.h"
+
+void llenar_disco(GestorDisco &gestor, float ocupacion, std::mt19937 &gen,
+                  ExtensionesVivas &vivas)
+{
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+
+    // Fase 1: llenar hasta que una allocación falle
+    while (true)
+    {
+        IndiceBloque tamanio = dist_tam(gen);
+        IndiceBloque inicio = gestor.allocar(tamanio);
+        if (inicio == -1)
+            break;
+        vivas.push_back({inicio, tamanio});
+    }
+
+    // Fase 2: liberar al azar hasta la ocupación pedida
+    IndiceBloque objetivo = static_cast<IndiceBloque>(ocupacion * gestor.get_total_bloques());
+    while (!vivas.empty() && gestor.get_bloques_ocupados() > objetivo)
+    {
+        std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+        size_t i = dist_indice(gen);
+
+        gestor.liberar(vivas[i].first, vivas[i].second);
+        vivas[i] = vivas.back();
+        vivas.pop_back();
+    }
+}
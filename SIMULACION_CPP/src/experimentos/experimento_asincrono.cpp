@@ -0,0 +1,212 @@
+/*
+ * experimento_asincrono.cpp
+ *
+ * Modo --modo asincrono: throughput de I/O real según cuántas peticiones
+ * hay en vuelo (core/motor_io.h), sobre la disposición de bloques que
+ * deja cada estructura.
+ *
+ * DISPOSICIÓN (MapaDeBits, ListaSimple, ListaDoble; misma semilla):
+ * - llenar_disco() hasta la ocupación pedida y OPERACIONES operaciones
+ *   más (allocar 1-64 / liberar), con el dispositivo nulo
+ * - Las extensiones vivas al final son "los archivos": cada una se parte
+ *   en peticiones de hasta BLOQUES_POR_PETICION bloques, en el orden en
+ *   que quedaron
+ *
+ * MEDICIÓN (por disposición, motor y profundidad 1, 2, 4 ... --profundidad):
+ * - Escritura de todas las peticiones + fdatasync, y después su lectura
+ * - Se mantienen en vuelo hasta `profundidad` peticiones: se envía hasta
+ *   llenar, se cosecha al menos una, se vuelve a llenar
+ * - Motores: io_uring (si el kernel lo tiene) y el pool de hilos
+ *
+ * Sin --directo 1 las lecturas salen del page cache; con O_DIRECT van al
+ * dispositivo, que es donde la profundidad de cola importa.
+ */
+
+#include "experimentos.h"
+#include "core/imagen_disco.h"
+#include "core/motor_io.h"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+
+const int OPERACIONES = 20000;
+const unsigned SEMILLA = 4242;
+const size_t ESTRUCTURAS_MEDIDAS = 3; // MapaDeBits, ListaSimple, ListaDoble
+
+struct Disposicion
+{
+    std::string estructura;
+    std::vector<PeticionIO> peticiones;
+    long long extensiones;
+    long long bloques;
+};
+
+Disposicion armar_disposicion(const ConfiguracionSimulacion &config, size_t indice)
+{
+    auto gestor = crear_gestor(indice, config.total_bloques, config.tamanio_bloque);
+    gestor->set_dispositivo(crear_modelo_dispositivo("nulo", config.tamanio_bloque));
+
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas vivas;
+    llenar_disco(*gestor, config.ocupacion_inicial, gen, vivas);
+
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 64);
+    for (int op = 0; op < OPERACIONES; op++)
+    {
+        if (vivas.empty() || gen() % 2 == 0)
+        {
+            IndiceBloque tamanio = dist_tam(gen);
+            IndiceBloque inicio = gestor->allocar(tamanio);
+            if (inicio != -1)
+                vivas.push_back({inicio, tamanio});
+        }
+        else
+        {
+            std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+            size_t k = dist_indice(gen);
+            gestor->liberar(vivas[k].first, vivas[k].second);
+            vivas[k] = vivas.back();
+            vivas.pop_back();
+        }
+    }
+
+    Disposicion disposicion;
+    disposicion.estructura = gestor->obtener_nombre();
+    disposicion.extensiones = static_cast<long long>(vivas.size());
+    disposicion.bloques = 0;
+    for (const auto &[inicio, tamanio] : vivas)
+    {
+        for (IndiceBloque hecho = 0; hecho < tamanio; hecho += MotorIO::BLOQUES_POR_PETICION)
+        {
+            IndiceBloque bloques = std::min<IndiceBloque>(MotorIO::BLOQUES_POR_PETICION, tamanio - hecho);
+            disposicion.peticiones.push_back({inicio + hecho, bloques, true, 0});
+        }
+        disposicion.bloques += tamanio;
+    }
+    return disposicion;
+}
+
+// Una pasada de todas las peticiones con hasta get_profundidad() en
+// vuelo. Las completadas que no transfirieron todo cuentan en `errores`.
+// Retorna: segundos (escritura: con el fdatasync final), o -1 si el motor falló
+
+double correr_pasada(MotorIO &motor, ImagenDisco &imagen, const std::vector<PeticionIO> &peticiones,
+                     bool escritura, int tamanio_bloque, long long &errores)
+{
+    std::vector<CompletadaIO> completadas;
+    size_t siguiente = 0;
+    size_t terminadas = 0;
+
+    auto comienzo = std::chrono::steady_clock::now();
+    while (terminadas < peticiones.size())
+    {
+        while (siguiente < peticiones.size())
+        {
+            PeticionIO peticion = peticiones[siguiente];
+            peticion.escritura = escritura;
+            peticion.etiqueta = siguiente;
+            if (!motor.enviar(peticion))
+                break;
+            siguiente++;
+        }
+
+        completadas.clear();
+        if (motor.cosechar(completadas, 1) == 0)
+            return -1.0;
+
+        for (const CompletadaIO &completada : completadas)
+        {
+            int64_t esperado = peticiones[completada.etiqueta].bloques * tamanio_bloque;
+            if (completada.resultado != esperado)
+                errores++;
+        }
+        terminadas += completadas.size();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - comienzo).count();
+
+    if (escritura)
+        segundos += imagen.sincronizar() / 1e6;
+    return segundos;
+}
+
+} // namespace
+
+int experimento_asincrono(const ConfiguracionSimulacion &config)
+{
+    std::vector<unsigned> profundidades;
+    for (int p = 1; p < config.profundidad_cola; p *= 2)
+        profundidades.push_back(static_cast<unsigned>(p));
+    profundidades.push_back(static_cast<unsigned>(config.profundidad_cola));
+
+    ImagenDisco imagen(config.imagen, config.total_bloques, config.tamanio_bloque, config.directo);
+    if (!imagen.abierta())
+        return 1;
+
+    std::vector<std::string> motores = {"hilos"};
+    if (MotorIoUring(imagen.get_fd(), config.tamanio_bloque, 1).disponible())
+        motores.insert(motores.begin(), "uring");
+
+    std::cout << "Experimento: I/O asíncrono, throughput según la profundidad de cola\n"
+              << "  Imagen: " << config.imagen << ", " << config.total_bloques << " bloques de "
+              << config.tamanio_bloque << " bytes" << (config.directo ? ", O_DIRECT" : ", con page cache") << "\n"
+              << "  Motores: " << (motores.size() == 2 ? "io_uring y hilos" : "hilos (sin io_uring en este kernel)")
+              << ", hasta " << MotorIO::BLOQUES_POR_PETICION << " bloques por petición\n\n";
+
+    std::cout << std::left << std::setw(25) << "Estructura"
+              << std::setw(10) << "Motor"
+              << std::setw(7) << "Prof."
+              << std::setw(12) << "Peticiones"
+              << std::setw(9) << "MB"
+              << std::setw(15) << "Escritura MB/s"
+              << "Lectura MB/s\n";
+    std::cout << std::string(90, '-') << "\n";
+
+    long long errores = 0;
+    for (size_t g = 0; g < ESTRUCTURAS_MEDIDAS; g++)
+    {
+        Disposicion disposicion = armar_disposicion(config, g);
+        double megabytes = static_cast<double>(disposicion.bloques) * config.tamanio_bloque / (1024.0 * 1024.0);
+
+        for (const std::string &nombre_motor : motores)
+        {
+            for (unsigned profundidad : profundidades)
+            {
+                auto motor = crear_motor_io(nombre_motor, imagen.get_fd(), config.tamanio_bloque, profundidad);
+                if (motor == nullptr)
+                    return 1;
+
+                double escritura = correr_pasada(*motor, imagen, disposicion.peticiones, true,
+                                                 config.tamanio_bloque, errores);
+                double lectura = correr_pasada(*motor, imagen, disposicion.peticiones, false,
+                                               config.tamanio_bloque, errores);
+                if (escritura < 0.0 || lectura < 0.0)
+                    return 1;
+
+                std::cout << std::left << std::setw(25) << disposicion.estructura
+                          << std::setw(10) << motor->nombre()
+                          << std::setw(7) << profundidad
+                          << std::setw(12) << disposicion.peticiones.size()
+                          << std::fixed << std::setprecision(1)
+                          << std::setw(9) << megabytes
+                          << std::setw(15) << (escritura > 0.0 ? megabytes / escritura : 0.0)
+                          << (lectura > 0.0 ? megabytes / lectura : 0.0) << "\n";
+            }
+        }
+        std::cout << "  " << disposicion.extensiones << " extensiones, "
+                  << std::setprecision(1) << static_cast<double>(disposicion.bloques) / std::max(1LL, disposicion.extensiones)
+                  << " bloques de media\n";
+    }
+
+    std::remove(config.imagen.c_str());
+
+    if (errores > 0)
+    {
+        std::cout << "\n¡" << errores << " peticiones no transfirieron todos sus bytes!\n";
+        return 1;
+    }
+    return 0;
+}
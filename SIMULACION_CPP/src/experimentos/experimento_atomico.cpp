@@ -0,0 +1,189 @@
+/*
+ * experimento_atomico.cpp
+ *
+ * Modo --modo atomico: latencia de allocación bajo contención del mapa
+ * de bits sin locks (MapaDeBitsAtomico) contra un MapaDeBits detrás de
+ * un único mutex (GestorConcurrente con un solo grupo).
+ *
+ * CARGA (igual para las dos variantes, semilla por hilo):
+ * - Cada hilo hace OPS_POR_HILO operaciones: mientras tenga menos de su
+ *   parte de la ocupación pedida alloca 1-32 bloques (a veces 65-128,
+ *   para ejercitar las rachas que cruzan palabras); si no, libera una
+ *   de sus extensiones al azar
+ * - Se cronometra cada allocar() por separado (ns de reloj real) en un
+ *   histograma por hilo; se combinan al terminar
+ *
+ * Las dos variantes usan el dispositivo nulo: el mapa atómico no tiene
+ * reloj virtual y cobrar el HDD dentro del mutex solo alargaría la
+ * sección crítica del otro.
+ */
+
+#include "experimentos.h"
+#include "core/gestor_concurrente.h"
+#include "core/histograma_latencia.h"
+#include "core/mapa_bits_atomico.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+
+const long long OPS_POR_HILO = 50000;
+const unsigned SEMILLA = 99;
+
+struct ResultadoContencion
+{
+    double ops_por_segundo;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    bool consistente;
+};
+
+template <typename Volumen>
+void escritor(Volumen &volumen, int id, IndiceBloque objetivo,
+              const std::atomic<bool> &largada, HistogramaLatencia &latencias)
+{
+    std::mt19937 gen(SEMILLA + id);
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+    std::uniform_int_distribution<IndiceBloque> dist_grande(65, 128);
+    ExtensionesVivas vivas;
+    IndiceBloque propios = 0;
+
+    while (!largada.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    for (long long op = 0; op < OPS_POR_HILO; op++)
+    {
+        if (propios < objetivo || vivas.empty())
+        {
+            IndiceBloque tamanio = (gen() % 16 == 0) ? dist_grande(gen) : dist_tam(gen);
+
+            auto antes = std::chrono::steady_clock::now();
+            IndiceBloque inicio = volumen.allocar(tamanio);
+            auto despues = std::chrono::steady_clock::now();
+            latencias.registrar(std::chrono::duration_cast<std::chrono::nanoseconds>(despues - antes).count());
+
+            if (inicio != -1)
+            {
+                vivas.push_back({inicio, tamanio});
+                propios += tamanio;
+                continue;
+            }
+            if (vivas.empty())
+                continue;
+        }
+
+        std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+        size_t k = dist_indice(gen);
+        volumen.liberar(vivas[k].first, vivas[k].second);
+        propios -= vivas[k].second;
+        vivas[k] = vivas.back();
+        vivas.pop_back();
+    }
+
+    for (const Extension &extension : vivas)
+        volumen.liberar(extension.first, extension.second);
+}
+
+template <typename Volumen>
+ResultadoContencion correr_contencion(Volumen &volumen, const ConfiguracionSimulacion &config, int hilos)
+{
+    IndiceBloque objetivo = static_cast<IndiceBloque>(config.ocupacion_inicial * config.total_bloques) / hilos;
+    std::atomic<bool> largada(false);
+    std::vector<HistogramaLatencia> latencias(hilos);
+    std::vector<std::thread> escritores;
+
+    for (int id = 0; id < hilos; id++)
+    {
+        escritores.emplace_back(escritor<Volumen>, std::ref(volumen), id, objetivo,
+                                std::cref(largada), std::ref(latencias[id]));
+    }
+
+    auto comienzo = std::chrono::steady_clock::now();
+    largada.store(true, std::memory_order_release);
+    for (auto &hilo : escritores)
+        hilo.join();
+    auto fin = std::chrono::steady_clock::now();
+
+    HistogramaLatencia todas;
+    for (const auto &propias : latencias)
+        todas.combinar(propias);
+
+    double segundos = std::chrono::duration<double>(fin - comienzo).count();
+
+    ResultadoContencion resultado;
+    resultado.ops_por_segundo = segundos > 0.0 ? OPS_POR_HILO * hilos / segundos : 0.0;
+    resultado.p50_ns = todas.percentil(0.50);
+    resultado.p99_ns = todas.percentil(0.99);
+    resultado.p999_ns = todas.percentil(0.999);
+    resultado.max_ns = todas.get_maximo();
+    resultado.consistente = volumen.verificar_metricas() && volumen.get_bloques_ocupados() == 0;
+    return resultado;
+}
+
+void imprimir_fila(const std::string &variante, int hilos, const ResultadoContencion &r)
+{
+    std::cout << std::left << std::setw(22) << variante
+              << std::setw(7) << hilos
+              << std::fixed << std::setprecision(0)
+              << std::setw(13) << r.ops_por_segundo
+              << std::setw(10) << r.p50_ns
+              << std::setw(10) << r.p99_ns
+              << std::setw(10) << r.p999_ns
+              << r.max_ns
+              << (r.consistente ? "" : "  ¡INCONSISTENTE!") << "\n";
+}
+
+} // namespace
+
+int experimento_atomico(const ConfiguracionSimulacion &config)
+{
+    std::vector<int> cantidades;
+    for (int hilos = 1; hilos < config.hilos; hilos *= 2)
+        cantidades.push_back(hilos);
+    cantidades.push_back(config.hilos);
+
+    std::cout << "Experimento: mapa de bits sin locks (CAS) vs mapa de bits con mutex\n"
+              << "  Disco: " << config.total_bloques << " bloques, " << OPS_POR_HILO
+              << " operaciones por hilo\n"
+              << "  Latencia de cada allocar() en ns de reloj real\n\n";
+
+    std::cout << std::left << std::setw(22) << "Variante"
+              << std::setw(7) << "Hilos"
+              << std::setw(13) << "ops/s"
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9"
+              << "max\n";
+    std::cout << std::string(80, '-') << "\n";
+
+    bool todo_consistente = true;
+    for (int hilos : cantidades)
+    {
+        MapaDeBitsAtomico atomico(config.total_bloques, config.tamanio_bloque);
+        ResultadoContencion r_atomico = correr_contencion(atomico, config, hilos);
+
+        FabricaGestor fabrica = [](IndiceBloque bloques, int tamanio_bloque)
+        {
+            auto gestor = crear_gestor(0, bloques, tamanio_bloque); // MapaDeBits
+            gestor->set_dispositivo(crear_modelo_dispositivo("nulo", tamanio_bloque));
+            return gestor;
+        };
+        GestorConcurrente con_mutex(1, fabrica, config.total_bloques, config.tamanio_bloque);
+        ResultadoContencion r_mutex = correr_contencion(con_mutex, config, hilos);
+
+        imprimir_fila("Sin locks (CAS)", hilos, r_atomico);
+        imprimir_fila("MapaDeBits + mutex", hilos, r_mutex);
+        std::cout << "  reintentos de CAS: " << atomico.get_reintentos_cas()
+                  << ", rachas deshechas: " << atomico.get_retrocesos() << "\n";
+
+        todo_consistente = todo_consistente && r_atomico.consistente && r_mutex.consistente;
+    }
+
+    return todo_consistente ? 0 : 1;
+}
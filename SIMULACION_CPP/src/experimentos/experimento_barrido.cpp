@@ -0,0 +1,246 @@
+/*
+ * experimento_barrido.cpp
+ *
+ * Modo --modo barrido: la carga mixta de allocaciones y liberaciones
+ * sobre una rejilla de parámetros, para ver en qué tamaño de volumen
+ * conviene cada estructura.
+ *
+ * REJILLA (cada combinación es una celda):
+ *   --barrido-bloques     tamaños de disco          16384,262144
+ *   --barrido-ocupacion   ocupación inicial         0.5,0.7,0.9
+ *   --barrido-tamanios    rangos de pedido          1-32,1-256
+ *   --barrido-ops         operaciones por celda     1000,10000
+ *
+ * CELDA (por estructura, misma semilla → mismos pedidos para todas):
+ * - llenar_disco() hasta la ocupación de la celda
+ * - `ops` operaciones: con probabilidad 1/2 allocar un tamaño del rango,
+ *   si no liberar una extensión viva al azar
+ * - Cada operación se cronometra (ns) en un histograma por tipo
+ *
+ * SALIDA: una fila por celda y estructura en --salida, CSV o JSON según
+ * la extensión, con ops/s, p50/p99 de cada operación, fallos,
+ * fragmentación final, uso_memoria() y tiempo de dispositivo.
+ */
+
+#include "experimentos.h"
+#include "core/histograma_latencia.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+
+const unsigned SEMILLA = 31337;
+
+struct FilaBarrido
+{
+    IndiceBloque bloques;
+    float ocupacion;
+    RangoTamanios tamanios;
+    int operaciones;
+    std::string estructura;
+    double ops_por_segundo;
+    uint64_t allocacion_p50_ns;
+    uint64_t allocacion_p99_ns;
+    uint64_t liberacion_p50_ns;
+    uint64_t liberacion_p99_ns;
+    long long fallos;     // Allocaciones que devolvieron -1
+    float fragmentacion;  // Al terminar
+    size_t memoria_bytes; // uso_memoria() al terminar
+    double dispositivo_ms;
+};
+
+uint64_t ns_desde(std::chrono::steady_clock::time_point comienzo)
+{
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(fin - comienzo).count();
+}
+
+FilaBarrido correr_celda(const ConfiguracionSimulacion &config, size_t indice, IndiceBloque bloques,
+                         float ocupacion, RangoTamanios tamanios, int operaciones)
+{
+    auto gestor = crear_gestor(indice, bloques, config.tamanio_bloque);
+    gestor->set_dispositivo(crear_modelo_dispositivo(config.dispositivo, config.tamanio_bloque));
+
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas vivas;
+    llenar_disco(*gestor, ocupacion, gen, vivas);
+
+    std::uniform_int_distribution<IndiceBloque> dist_tam(tamanios.first, tamanios.second);
+    HistogramaLatencia latencia_allocacion;
+    HistogramaLatencia latencia_liberacion;
+    uint64_t total_ns = 0;
+    long long fallos = 0;
+    double reloj_inicial = gestor->get_tiempo_virtual_us();
+
+    for (int op = 0; op < operaciones; op++)
+    {
+        if (vivas.empty() || gen() % 2 == 0)
+        {
+            IndiceBloque tamanio = dist_tam(gen);
+            auto comienzo = std::chrono::steady_clock::now();
+            IndiceBloque inicio = gestor->allocar(tamanio);
+            uint64_t ns = ns_desde(comienzo);
+
+            latencia_allocacion.registrar(ns);
+            total_ns += ns;
+            if (inicio == -1)
+                fallos++;
+            else
+                vivas.push_back({inicio, tamanio});
+        }
+        else
+        {
+            std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+            size_t k = dist_indice(gen);
+            auto comienzo = std::chrono::steady_clock::now();
+            gestor->liberar(vivas[k].first, vivas[k].second);
+            uint64_t ns = ns_desde(comienzo);
+
+            latencia_liberacion.registrar(ns);
+            total_ns += ns;
+            vivas[k] = vivas.back();
+            vivas.pop_back();
+        }
+    }
+
+    FilaBarrido fila;
+    fila.bloques = bloques;
+    fila.ocupacion = ocupacion;
+    fila.tamanios = tamanios;
+    fila.operaciones = operaciones;
+    fila.estructura = gestor->obtener_nombre();
+    fila.ops_por_segundo = total_ns > 0 ? operaciones / (total_ns / 1e9) : 0.0;
+    fila.allocacion_p50_ns = latencia_allocacion.percentil(0.50);
+    fila.allocacion_p99_ns = latencia_allocacion.percentil(0.99);
+    fila.liberacion_p50_ns = latencia_liberacion.percentil(0.50);
+    fila.liberacion_p99_ns = latencia_liberacion.percentil(0.99);
+    fila.fallos = fallos;
+    fila.fragmentacion = gestor->get_fragmentacion();
+    fila.memoria_bytes = gestor->uso_memoria();
+    fila.dispositivo_ms = (gestor->get_tiempo_virtual_us() - reloj_inicial) / 1000.0;
+    return fila;
+}
+
+// ============================================================================
+// ESCRITURA (CSV o JSON, mismas columnas)
+// ============================================================================
+
+void escribir_csv(std::ostream &salida, const std::vector<FilaBarrido> &filas)
+{
+    salida << "bloques,ocupacion,tamanio_min,tamanio_max,operaciones,estructura,ops_por_segundo,"
+              "allocacion_p50_ns,allocacion_p99_ns,liberacion_p50_ns,liberacion_p99_ns,"
+              "fallos,fragmentacion,memoria_bytes,dispositivo_ms\n";
+
+    for (const FilaBarrido &f : filas)
+    {
+        salida << f.bloques << "," << f.ocupacion << "," << f.tamanios.first << "," << f.tamanios.second
+               << "," << f.operaciones << "," << f.estructura << ","
+               << std::fixed << std::setprecision(0) << f.ops_por_segundo << ","
+               << f.allocacion_p50_ns << "," << f.allocacion_p99_ns << ","
+               << f.liberacion_p50_ns << "," << f.liberacion_p99_ns << ","
+               << f.fallos << "," << std::setprecision(2) << f.fragmentacion << ","
+               << f.memoria_bytes << "," << f.dispositivo_ms << "\n";
+        salida.unsetf(std::ios::fixed);
+    }
+}
+
+void escribir_json(std::ostream &salida, const std::vector<FilaBarrido> &filas)
+{
+    salida << "[\n";
+    for (size_t i = 0; i < filas.size(); i++)
+    {
+        const FilaBarrido &f = filas[i];
+        salida << "  {\"bloques\": " << f.bloques
+               << ", \"ocupacion\": " << f.ocupacion
+               << ", \"tamanio_min\": " << f.tamanios.first
+               << ", \"tamanio_max\": " << f.tamanios.second
+               << ", \"operaciones\": " << f.operaciones
+               << ", \"estructura\": \"" << f.estructura << "\""
+               << std::fixed << std::setprecision(0)
+               << ", \"ops_por_segundo\": " << f.ops_por_segundo
+               << ", \"allocacion_p50_ns\": " << f.allocacion_p50_ns
+               << ", \"allocacion_p99_ns\": " << f.allocacion_p99_ns
+               << ", \"liberacion_p50_ns\": " << f.liberacion_p50_ns
+               << ", \"liberacion_p99_ns\": " << f.liberacion_p99_ns
+               << ", \"fallos\": " << f.fallos
+               << std::setprecision(2)
+               << ", \"fragmentacion\": " << f.fragmentacion
+               << ", \"memoria_bytes\": " << f.memoria_bytes
+               << ", \"dispositivo_ms\": " << f.dispositivo_ms
+               << "}" << (i + 1 < filas.size() ? "," : "") << "\n";
+        salida.unsetf(std::ios::fixed);
+    }
+    salida << "]\n";
+}
+
+bool termina_en(const std::string &texto, const std::string &sufijo)
+{
+    return texto.size() >= sufijo.size() &&
+           texto.compare(texto.size() - sufijo.size(), sufijo.size(), sufijo) == 0;
+}
+
+} // namespace
+
+int experimento_barrido(const ConfiguracionSimulacion &config)
+{
+    size_t num_celdas = config.barrido_bloques.size() * config.barrido_ocupaciones.size() *
+                        config.barrido_tamanios.size() * config.barrido_operaciones.size();
+
+    std::cout << "Experimento: barrido de parámetros (" << num_celdas << " celdas x "
+              << NUM_ESTRUCTURAS << " estructuras, dispositivo " << config.dispositivo << ")\n\n";
+
+    std::cout << std::left << std::setw(10) << "Bloques"
+              << std::setw(7) << "Ocup"
+              << std::setw(10) << "Tamaños"  // ñ ocupa 2 bytes
+              << std::setw(8) << "Ops"
+              << std::setw(25) << "Estructura"
+              << std::setw(12) << "Ops/s"
+              << std::setw(12) << "Alloc p99"
+              << "Memoria (KB)\n";
+    std::cout << std::string(96, '-') << "\n";
+
+    std::vector<FilaBarrido> filas;
+    for (IndiceBloque bloques : config.barrido_bloques)
+    {
+        for (float ocupacion : config.barrido_ocupaciones)
+        {
+            for (const RangoTamanios &tamanios : config.barrido_tamanios)
+            {
+                for (int operaciones : config.barrido_operaciones)
+                {
+                    for (size_t indice = 0; indice < NUM_ESTRUCTURAS; indice++)
+                    {
+                        FilaBarrido f = correr_celda(config, indice, bloques, ocupacion, tamanios, operaciones);
+
+                        std::cout << std::left << std::setw(10) << f.bloques
+                                  << std::fixed << std::setprecision(2) << std::setw(7) << f.ocupacion
+                                  << std::setw(9) << (std::to_string(tamanios.first) + "-" + std::to_string(tamanios.second))
+                                  << std::setw(8) << f.operaciones
+                                  << std::setw(25) << f.estructura
+                                  << std::setprecision(0) << std::setw(12) << f.ops_por_segundo
+                                  << std::setw(12) << f.allocacion_p99_ns
+                                  << std::setprecision(1) << f.memoria_bytes / 1024.0 << "\n";
+                        filas.push_back(f);
+                    }
+                }
+            }
+        }
+    }
+
+    std::ofstream archivo(config.salida);
+    if (!archivo.is_open())
+    {
+        std::cerr << "Error al abrir archivo de salida: " << config.salida << "\n";
+        return 1;
+    }
+    if (termina_en(config.salida, ".json"))
+        escribir_json(archivo, filas);
+    else
+        escribir_csv(archivo, filas);
+
+    std::cout << "\n" << filas.size() << " filas guardadas en: " << config.salida << "\n";
+    return 0;
+}
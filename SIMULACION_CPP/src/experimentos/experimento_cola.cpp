@@ -0,0 +1,151 @@
+/*
+ * experimento_cola.cpp
+ *
+ * Modo --modo cola: cuánto gana cada estructura si las peticiones pasan
+ * por una cola con planificador de ascensor en vez de atenderse de a
+ * una en orden de llegada.
+ *
+ * CARGA:
+ * - Disco llenado con llenar_disco() (misma semilla → mismo estado
+ *   inicial para todas las políticas de una estructura)
+ * - NUM_LOTES lotes de `profundidad_cola` peticiones encoladas de golpe
+ *   con la cola tapada (mitad allocaciones de 1-32 bloques, mitad
+ *   liberaciones de extensiones vivas elegidas al azar); se destapa y
+ *   se espera el lote completo
+ *
+ * Con el HDD la rotación pesa tanto como el seek: C-LOOK recorre cada
+ * pista en el sentido de giro del plato, mientras que la mitad de bajada
+ * de SCAN encuentra cada sector recién pasado y espera casi una vuelta.
+ */
+
+#include "experimentos.h"
+#include "core/cola_peticiones.h"
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+const int NUM_LOTES = 50;
+const unsigned SEMILLA = 2024;
+
+struct ResultadoCola
+{
+    EstadisticasCola estadisticas;
+    double tiempo_total_us; // Reloj virtual consumido por los lotes
+};
+
+ResultadoCola correr_politica(const ConfiguracionSimulacion &config, size_t indice_gestor,
+                              PoliticaCola politica)
+{
+    auto gestores = crear_gestores(config.total_bloques, config.tamanio_bloque);
+    GestorDisco &gestor = *gestores[indice_gestor];
+    gestor.set_dispositivo(crear_modelo_dispositivo(config.dispositivo, config.tamanio_bloque));
+
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas vivas;
+    llenar_disco(gestor, config.ocupacion_inicial, gen, vivas);
+
+    double reloj_inicial = gestor.get_tiempo_virtual_us();
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+    ResultadoCola resultado;
+
+    {
+        ColaPeticiones cola(&gestor, politica);
+
+        for (int lote = 0; lote < NUM_LOTES; lote++)
+        {
+            std::vector<std::pair<std::future<IndiceBloque>, IndiceBloque>> allocaciones;
+            std::vector<std::future<bool>> liberaciones;
+
+            cola.tapar();
+            for (int i = 0; i < config.profundidad_cola; i++)
+            {
+                if (vivas.empty() || gen() % 2 == 0)
+                {
+                    IndiceBloque tamanio = dist_tam(gen);
+                    allocaciones.push_back({cola.encolar_allocacion(tamanio), tamanio});
+                }
+                else
+                {
+                    std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+                    size_t k = dist_indice(gen);
+                    liberaciones.push_back(cola.encolar_liberacion(vivas[k].first, vivas[k].second));
+                    vivas[k] = vivas.back();
+                    vivas.pop_back();
+                }
+            }
+
+            cola.destapar();
+
+            for (auto &futuro : liberaciones)
+                futuro.get();
+            for (auto &[futuro, tamanio] : allocaciones)
+            {
+                IndiceBloque inicio = futuro.get();
+                if (inicio != -1)
+                    vivas.push_back({inicio, tamanio});
+            }
+        }
+
+        cola.esperar_vacia();
+        resultado.estadisticas = cola.get_estadisticas();
+    }
+
+    resultado.tiempo_total_us = gestor.get_tiempo_virtual_us() - reloj_inicial;
+    return resultado;
+}
+
+} // namespace
+
+int experimento_cola(const ConfiguracionSimulacion &config)
+{
+    const PoliticaCola politicas[] = {FIFO, SCAN, CLOOK};
+    size_t num_gestores = crear_gestores(1).size();
+
+    std::cout << "Experimento: cola de peticiones con planificador de ascensor\n"
+              << "  Disco: " << config.total_bloques << " bloques, dispositivo "
+              << config.dispositivo << ", " << NUM_LOTES << " lotes de "
+              << config.profundidad_cola << " peticiones\n"
+              << "  Tiempos en ms del reloj virtual\n\n";
+
+    std::cout << std::left << std::setw(25) << "Estructura"
+              << std::setw(10) << "Política"
+              << std::setw(12) << "Total"
+              << std::setw(12) << "Espera"
+              << std::setw(12) << "Servicio"
+              << std::setw(12) << "Prof.media"
+              << std::setw(10) << "Prof.max"
+              << "Ganancia\n";
+    std::cout << std::string(100, '-') << "\n";
+
+    for (size_t g = 0; g < num_gestores; g++)
+    {
+        std::string nombre = crear_gestores(1)[g]->obtener_nombre();
+        double total_fifo = 0.0;
+
+        for (PoliticaCola politica : politicas)
+        {
+            ResultadoCola r = correr_politica(config, g, politica);
+            if (politica == FIFO)
+                total_fifo = r.tiempo_total_us;
+
+            std::cout << std::left << std::setw(25) << nombre
+                      << std::setw(9) << nombre_politica(politica)
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(12) << r.tiempo_total_us / 1000.0
+                      << std::setw(12) << r.estadisticas.espera_media_us() / 1000.0
+                      << std::setw(12) << r.estadisticas.servicio_medio_us() / 1000.0
+                      << std::setw(12) << r.estadisticas.profundidad_media()
+                      << std::setw(10) << r.estadisticas.profundidad_maxima;
+            if (r.tiempo_total_us > 0.0)
+                std::cout << total_fifo / r.tiempo_total_us << "x";
+            std::cout << "\n";
+        }
+    }
+
+    std::cout << "\nGanancia = tiempo total FIFO / tiempo total de la política\n";
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * experimento_concurrente.cpp
+ *
+ * Modo --modo concurrente: prueba de estrés con varios escritores contra
+ * un mismo volumen (GestorConcurrente) y cuánto escala de 1 a --hilos.
+ *
+ * CARGA (por hilo, con su propia semilla):
+ * - OPS_TOTALES operaciones repartidas entre los hilos (mismo trabajo
+ *   total para cada cantidad de hilos)
+ * - Mientras el hilo tenga menos de su parte de la ocupación pedida,
+ *   alloca 1-32 bloques; si no, libera una de sus extensiones al azar
+ * - Al final cada hilo libera todo lo suyo: el volumen debe quedar vacío
+ *
+ * Se compara el gestor con un grupo por hilo máximo contra el mismo
+ * gestor con un solo grupo (un único mutex global).
+ */
+
+#include "experimentos.h"
+#include "core/gestor_concurrente.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+
+const long long OPS_TOTALES = 200000;
+const unsigned SEMILLA = 77;
+
+struct ResultadoEstres
+{
+    double ops_por_segundo;
+    long long derrames;
+    bool consistente; // Métricas bien y volumen vacío al terminar
+};
+
+void escritor(GestorConcurrente &volumen, int id, long long operaciones,
+              IndiceBloque objetivo, const std::atomic<bool> &largada)
+{
+    std::mt19937 gen(SEMILLA + id);
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+    ExtensionesVivas vivas;
+    IndiceBloque propios = 0;
+
+    while (!largada.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    for (long long op = 0; op < operaciones; op++)
+    {
+        if (propios < objetivo || vivas.empty())
+        {
+            IndiceBloque tamanio = dist_tam(gen);
+            IndiceBloque inicio = volumen.allocar(tamanio);
+            if (inicio != -1)
+            {
+                vivas.push_back({inicio, tamanio});
+                propios += tamanio;
+                continue;
+            }
+            if (vivas.empty())
+                continue; // Volumen lleno y nada propio para soltar
+        }
+
+        std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+        size_t k = dist_indice(gen);
+        volumen.liberar(vivas[k].first, vivas[k].second);
+        propios -= vivas[k].second;
+        vivas[k] = vivas.back();
+        vivas.pop_back();
+    }
+
+    for (const Extension &extension : vivas)
+        volumen.liberar(extension.first, extension.second);
+}
+
+ResultadoEstres correr_estres(const ConfiguracionSimulacion &config, size_t indice_gestor,
+                              size_t num_grupos, int hilos)
+{
+    FabricaGestor fabrica = [&](IndiceBloque bloques, int tamanio_bloque)
+    {
+        auto gestor = crear_gestor(indice_gestor, bloques, tamanio_bloque);
+        gestor->set_dispositivo(crear_modelo_dispositivo(config.dispositivo, tamanio_bloque));
+        return gestor;
+    };
+    GestorConcurrente volumen(num_grupos, fabrica, config.total_bloques, config.tamanio_bloque);
+
+    IndiceBloque objetivo = static_cast<IndiceBloque>(config.ocupacion_inicial * config.total_bloques) / hilos;
+    std::atomic<bool> largada(false);
+    std::vector<std::thread> escritores;
+
+    for (int id = 0; id < hilos; id++)
+    {
+        escritores.emplace_back(escritor, std::ref(volumen), id, OPS_TOTALES / hilos,
+                                objetivo, std::cref(largada));
+    }
+
+    auto comienzo = std::chrono::steady_clock::now();
+    largada.store(true, std::memory_order_release);
+    for (auto &hilo : escritores)
+        hilo.join();
+    auto fin = std::chrono::steady_clock::now();
+
+    double segundos = std::chrono::duration<double>(fin - comienzo).count();
+
+    ResultadoEstres resultado;
+    resultado.ops_por_segundo = segundos > 0.0 ? (OPS_TOTALES / hilos) * hilos / segundos : 0.0;
+    resultado.derrames = volumen.get_derrames();
+    resultado.consistente = volumen.verificar_metricas() && volumen.get_bloques_ocupados() == 0;
+    return resultado;
+}
+
+} // namespace
+
+int experimento_concurrente(const ConfiguracionSimulacion &config)
+{
+    // 1, 2, 4, ... y siempre el máximo pedido
+    std::vector<int> cantidades;
+    for (int hilos = 1; hilos < config.hilos; hilos *= 2)
+        cantidades.push_back(hilos);
+    cantidades.push_back(config.hilos);
+
+    const size_t num_grupos = static_cast<size_t>(config.hilos);
+
+    std::cout << "Experimento: escritores concurrentes con grupos de allocación\n"
+              << "  Disco: " << config.total_bloques << " bloques, dispositivo "
+              << config.dispositivo << ", " << OPS_TOTALES << " operaciones repartidas entre los hilos\n"
+              << "  Núcleos disponibles: " << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout << std::left << std::setw(25) << "Estructura"
+              << std::setw(7) << "Hilos"
+              << std::setw(17) << ("ops/s " + std::to_string(num_grupos) + " grupos")
+              << std::setw(16) << "ops/s 1 grupo"
+              << std::setw(11) << "Escalado"
+              << "Derrames\n";
+    std::cout << std::string(86, '-') << "\n";
+
+    bool todo_consistente = true;
+    for (size_t g = 0; g < NUM_ESTRUCTURAS; g++)
+    {
+        std::string nombre = crear_gestor(g, 1)->obtener_nombre();
+        double base_un_hilo = 0.0;
+
+        for (int hilos : cantidades)
+        {
+            ResultadoEstres grupos = correr_estres(config, g, num_grupos, hilos);
+            ResultadoEstres global = correr_estres(config, g, 1, hilos);
+            todo_consistente = todo_consistente && grupos.consistente && global.consistente;
+
+            if (hilos == 1)
+                base_un_hilo = grupos.ops_por_segundo;
+
+            std::cout << std::left << std::setw(25) << nombre
+                      << std::setw(7) << hilos
+                      << std::fixed << std::setprecision(0)
+                      << std::setw(17) << grupos.ops_por_segundo
+                      << std::setw(16) << global.ops_por_segundo
+                      << std::setprecision(2)
+                      << std::setw(11) << (base_un_hilo > 0.0 ? grupos.ops_por_segundo / base_un_hilo : 0.0)
+                      << grupos.derrames
+                      << (grupos.consistente && global.consistente ? "" : "  ¡INCONSISTENTE!") << "\n";
+        }
+    }
+
+    std::cout << "\nEscalado = ops/s con grupos / ops/s con grupos y 1 hilo\n";
+    return todo_consistente ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+/*
+ * experimento_diario.cpp
+ *
+ * Modo --modo diario: costo de hacer durable cada allocar / liberar con
+ * un diario de escritura anticipada (core/diario.h), con un fdatasync
+ * por operación contra commit en grupo, de 1 a --hilos clientes.
+ *
+ * CARGA (igual para las dos variantes, semilla por hilo):
+ * - MapaDeBits con el dispositivo nulo detrás de un mutex, llenado con
+ *   llenar_disco() hasta la ocupación pedida; se guarda el punto de
+ *   control inicial
+ * - Cada hilo hace OPS_POR_HILO operaciones: alloca 1-32 bloques mientras
+ *   tenga menos de su parte de OCUPACION_PROPIA; si no, libera una de sus
+ *   extensiones al azar
+ * - Cada operación: lock → allocar/liberar → agregar al diario → unlock,
+ *   y FUERA del lock esperar a que su registro esté en disco. Se mide
+ *   el tiempo hasta la confirmación (ns de reloj real)
+ *
+ * RECUPERACIÓN:
+ * Al terminar se agrega basura al final del diario (un registro a medio
+ * escribir, como tras un corte de luz) y se recupera en un MapaDeBits
+ * nuevo: debe quedar idéntico, palabra por palabra, al que se usó.
+ */
+
+#include "experimentos.h"
+#include "core/diario.h"
+#include "core/histograma_latencia.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+const long long OPS_POR_HILO = 1000;
+const float OCUPACION_PROPIA = 0.05f; // Del disco, repartida entre los hilos
+const unsigned SEMILLA = 131;
+
+const std::string ARCHIVO_DIARIO = "data/diario.wal";
+const std::string ARCHIVO_PUNTO_CONTROL = "data/diario_estado.bin";
+
+struct ResultadoDiario
+{
+    double ops_por_segundo;
+    double sincronizaciones_por_segundo;
+    double registros_por_sincronizacion;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+    bool recuperado; // Estado recuperado idéntico al final
+};
+
+void cliente(GestorDisco &gestor, std::mutex &mutex_gestor, Diario &diario, int id,
+             IndiceBloque objetivo, const std::atomic<bool> &largada,
+             HistogramaLatencia &latencias, std::atomic<bool> &fallo)
+{
+    std::mt19937 gen(SEMILLA + id);
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+    ExtensionesVivas vivas;
+    IndiceBloque propios = 0;
+
+    while (!largada.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    for (long long op = 0; op < OPS_POR_HILO; op++)
+    {
+        auto antes = std::chrono::steady_clock::now();
+        uint64_t secuencia = 0;
+
+        if (propios < objetivo || vivas.empty())
+        {
+            IndiceBloque tamanio = dist_tam(gen);
+            std::unique_lock<std::mutex> lock(mutex_gestor);
+            IndiceBloque inicio = gestor.allocar(tamanio);
+            if (inicio != -1)
+                secuencia = diario.agregar(DIARIO_ALLOCAR, inicio, tamanio);
+            lock.unlock();
+
+            if (inicio != -1)
+            {
+                vivas.push_back({inicio, tamanio});
+                propios += tamanio;
+            }
+        }
+        else
+        {
+            std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+            size_t k = dist_indice(gen);
+            {
+                std::lock_guard<std::mutex> lock(mutex_gestor);
+                gestor.liberar(vivas[k].first, vivas[k].second);
+                secuencia = diario.agregar(DIARIO_LIBERAR, vivas[k].first, vivas[k].second);
+            }
+            propios -= vivas[k].second;
+            vivas[k] = vivas.back();
+            vivas.pop_back();
+        }
+
+        if (secuencia != 0 && !diario.esperar(secuencia))
+            fallo.store(true, std::memory_order_relaxed);
+
+        auto despues = std::chrono::steady_clock::now();
+        latencias.registrar(std::chrono::duration_cast<std::chrono::nanoseconds>(despues - antes).count());
+    }
+}
+
+// El punto de control y recuperar() avisan por std::cout al guardar y
+// cargar el estado: callarlos para no cortar la tabla
+
+class SilenciarSalida
+{
+private:
+    std::ostringstream descarte;
+    std::streambuf *anterior;
+
+public:
+    SilenciarSalida() : anterior(std::cout.rdbuf(descarte.rdbuf())) {}
+    ~SilenciarSalida() { std::cout.rdbuf(anterior); }
+};
+
+// Simular un corte a mitad de una escritura: medio registro de basura
+// al final del diario
+
+void cortar_diario()
+{
+    std::ofstream archivo(ARCHIVO_DIARIO, std::ios::binary | std::ios::app);
+    std::string basura(sizeof(RegistroDiario) / 2, '\x5a');
+    archivo.write(basura.data(), basura.size());
+}
+
+ResultadoDiario correr_diario(const ConfiguracionSimulacion &config, bool en_grupo, int hilos)
+{
+    std::remove(ARCHIVO_DIARIO.c_str());
+    std::remove(ARCHIVO_PUNTO_CONTROL.c_str());
+
+    MapaDeBits gestor(config.total_bloques, config.tamanio_bloque);
+    gestor.set_dispositivo(crear_modelo_dispositivo("nulo", config.tamanio_bloque));
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas previas;
+    llenar_disco(gestor, config.ocupacion_inicial, gen, previas);
+
+    ResultadoDiario resultado = {};
+    std::atomic<bool> fallo(false);
+    long long sincronizaciones = 0;
+    long long registros = 0;
+    double segundos = 0.0;
+    HistogramaLatencia todas;
+
+    {
+        Diario diario(ARCHIVO_DIARIO, config.total_bloques, en_grupo);
+        bool inicial;
+        {
+            SilenciarSalida silencio;
+            inicial = diario.abierto() && diario.punto_de_control(gestor, ARCHIVO_PUNTO_CONTROL);
+        }
+        if (!inicial)
+            return resultado;
+
+        IndiceBloque objetivo = static_cast<IndiceBloque>(OCUPACION_PROPIA * config.total_bloques) / hilos;
+        std::mutex mutex_gestor;
+        std::atomic<bool> largada(false);
+        std::vector<HistogramaLatencia> latencias(hilos);
+        std::vector<std::thread> clientes;
+
+        for (int id = 0; id < hilos; id++)
+        {
+            clientes.emplace_back(cliente, std::ref(gestor), std::ref(mutex_gestor), std::ref(diario),
+                                  id, objetivo, std::cref(largada), std::ref(latencias[id]), std::ref(fallo));
+        }
+
+        auto comienzo = std::chrono::steady_clock::now();
+        largada.store(true, std::memory_order_release);
+        for (auto &hilo : clientes)
+            hilo.join();
+        auto fin = std::chrono::steady_clock::now();
+
+        segundos = std::chrono::duration<double>(fin - comienzo).count();
+        sincronizaciones = diario.get_sincronizaciones();
+        registros = diario.get_registros_escritos();
+        for (const auto &propias : latencias)
+            todas.combinar(propias);
+    }
+
+    cortar_diario();
+
+    MapaDeBits recuperado(config.total_bloques, config.tamanio_bloque);
+    long long aplicados;
+    {
+        SilenciarSalida silencio;
+        aplicados = recuperado.recuperar(ARCHIVO_PUNTO_CONTROL, ARCHIVO_DIARIO);
+    }
+    if (aplicados < 0)
+        std::cerr << "No se pudo recuperar desde " << ARCHIVO_PUNTO_CONTROL << " + " << ARCHIVO_DIARIO << "\n";
+
+    const BitmapPalabras &original = gestor.get_disco();
+    const BitmapPalabras &copia = recuperado.get_disco();
+    resultado.recuperado = !fallo.load() && aplicados >= 0 && aplicados == registros &&
+                           recuperado.get_bloques_ocupados() == gestor.get_bloques_ocupados() &&
+                           std::memcmp(original.datos(), copia.datos(),
+                                       original.num_palabras() * sizeof(uint64_t)) == 0 &&
+                           recuperado.verificar_metricas();
+
+    resultado.ops_por_segundo = segundos > 0.0 ? OPS_POR_HILO * hilos / segundos : 0.0;
+    resultado.sincronizaciones_por_segundo = segundos > 0.0 ? sincronizaciones / segundos : 0.0;
+    resultado.registros_por_sincronizacion = sincronizaciones > 0 ? static_cast<double>(registros) / sincronizaciones : 0.0;
+    resultado.p50_ns = todas.percentil(0.50);
+    resultado.p99_ns = todas.percentil(0.99);
+    resultado.max_ns = todas.get_maximo();
+
+    std::remove(ARCHIVO_DIARIO.c_str());
+    std::remove(ARCHIVO_PUNTO_CONTROL.c_str());
+    return resultado;
+}
+
+void imprimir_fila(const std::string &variante, int hilos, const ResultadoDiario &r)
+{
+    std::cout << std::left << std::setw(23) << variante
+              << std::setw(7) << hilos
+              << std::fixed << std::setprecision(0)
+              << std::setw(10) << r.ops_por_segundo
+              << std::setw(10) << r.sincronizaciones_por_segundo
+              << std::setprecision(1)
+              << std::setw(11) << r.registros_por_sincronizacion
+              << std::setw(10) << r.p50_ns / 1000.0
+              << std::setw(10) << r.p99_ns / 1000.0
+              << std::setw(10) << r.max_ns / 1000.0
+              << (r.recuperado ? "OK" : "¡DISTINTO!") << "\n";
+}
+
+} // namespace
+
+int experimento_diario(const ConfiguracionSimulacion &config)
+{
+    std::vector<int> cantidades;
+    for (int hilos = 1; hilos < config.hilos; hilos *= 2)
+        cantidades.push_back(hilos);
+    cantidades.push_back(config.hilos);
+
+    std::cout << "Experimento: diario de escritura anticipada, fsync por operación vs commit en grupo\n"
+              << "  Disco: " << config.total_bloques << " bloques, " << OPS_POR_HILO
+              << " operaciones por hilo, diario en " << ARCHIVO_DIARIO << "\n"
+              << "  Confirmación = desde allocar/liberar hasta su registro en disco (µs de reloj real)\n\n";
+
+    std::cout << std::left << std::setw(23) << "Variante"
+              << std::setw(7) << "Hilos"
+              << std::setw(10) << "ops/s"
+              << std::setw(10) << "fsync/s"
+              << std::setw(11) << "reg/fsync"
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "max"
+              << "Recuperado\n";
+    std::cout << std::string(91, '-') << "\n";
+
+    bool todo_recuperado = true;
+    for (int hilos : cantidades)
+    {
+        ResultadoDiario por_operacion = correr_diario(config, false, hilos);
+        ResultadoDiario en_grupo = correr_diario(config, true, hilos);
+
+        imprimir_fila("fsync por registro", hilos, por_operacion);
+        imprimir_fila("Commit en grupo", hilos, en_grupo);
+
+        todo_recuperado = todo_recuperado && por_operacion.recuperado && en_grupo.recuperado;
+    }
+
+    std::cout << "\nRecuperado = punto de control + diario (con el final cortado) da el mismo mapa de bits\n";
+    return todo_recuperado ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*
+ * experimento_imagen.cpp
+ *
+ * Modo --modo imagen: la misma carga sobre cada estructura, pero con
+ * escrituras REALES en un archivo imagen (core/imagen_disco.h) en vez
+ * del reloj simulado. Mide cómo las posiciones que elige cada estructura
+ * se traducen en throughput de I/O sobre el almacenamiento propio.
+ *
+ * CARGA (por estructura, misma semilla → mismos pedidos para todas):
+ * - Dispositivo nulo y llenar_disco() hasta la ocupación pedida
+ * - Imagen nueva (--imagen, con O_DIRECT si --directo 1) enchufada con
+ *   set_dispositivo()
+ * - OPERACIONES operaciones: con probabilidad 1/2 allocar 1-64 bloques
+ *   (se escriben todos, un pwritev por extensión), si no liberar una
+ *   extensión viva al azar (se escribe su primer bloque)
+ * - fdatasync al final, dentro de la medición
+ *
+ * La imagen se borra al terminar cada estructura (todas arrancan de un
+ * archivo disperso recién creado, en igualdad de condiciones).
+ */
+
+#include "experimentos.h"
+#include "core/imagen_disco.h"
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+
+const int OPERACIONES = 20000;
+const unsigned SEMILLA = 4242;
+
+struct ResultadoImagen
+{
+    std::string estructura;
+    double megabytes;
+    long long llamadas;
+    double bloques_por_llamada;
+    double distancia_media; // Bloques saltados entre escrituras
+    double io_ms;           // Escrituras + fdatasync final
+    double megabytes_por_segundo;
+    long long fallos;       // Allocaciones que devolvieron -1
+    long long errores;      // Escrituras que fallaron
+};
+
+bool correr_imagen(const ConfiguracionSimulacion &config, size_t indice, ResultadoImagen &resultado)
+{
+    auto gestor = crear_gestor(indice, config.total_bloques, config.tamanio_bloque);
+    gestor->set_dispositivo(crear_modelo_dispositivo("nulo", config.tamanio_bloque));
+
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas vivas;
+    llenar_disco(*gestor, config.ocupacion_inicial, gen, vivas);
+
+    std::remove(config.imagen.c_str());
+    auto imagen = std::make_unique<ImagenDisco>(config.imagen, config.total_bloques,
+                                                config.tamanio_bloque, config.directo);
+    if (!imagen->abierta())
+        return false;
+    ImagenDisco *dispositivo = imagen.get();
+    gestor->set_dispositivo(std::move(imagen));
+    double reloj_inicial = gestor->get_tiempo_virtual_us();
+
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 64);
+    long long fallos = 0;
+
+    for (int op = 0; op < OPERACIONES; op++)
+    {
+        if (vivas.empty() || gen() % 2 == 0)
+        {
+            IndiceBloque tamanio = dist_tam(gen);
+            IndiceBloque inicio = gestor->allocar(tamanio);
+            if (inicio == -1)
+                fallos++;
+            else
+                vivas.push_back({inicio, tamanio});
+        }
+        else
+        {
+            std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+            size_t k = dist_indice(gen);
+            gestor->liberar(vivas[k].first, vivas[k].second);
+            vivas[k] = vivas.back();
+            vivas.pop_back();
+        }
+    }
+
+    double io_us = gestor->get_tiempo_virtual_us() - reloj_inicial + dispositivo->sincronizar();
+    double megabytes = static_cast<double>(dispositivo->get_bloques_escritos()) *
+                       config.tamanio_bloque / (1024.0 * 1024.0);
+
+    resultado.estructura = gestor->obtener_nombre();
+    resultado.megabytes = megabytes;
+    resultado.llamadas = dispositivo->get_llamadas();
+    resultado.bloques_por_llamada = resultado.llamadas
+                                        ? static_cast<double>(dispositivo->get_bloques_escritos()) / resultado.llamadas
+                                        : 0.0;
+    resultado.distancia_media = dispositivo->get_distancia_media();
+    resultado.io_ms = io_us / 1000.0;
+    resultado.megabytes_por_segundo = io_us > 0.0 ? megabytes / (io_us / 1e6) : 0.0;
+    resultado.fallos = fallos;
+    resultado.errores = dispositivo->get_errores();
+
+    gestor.reset(); // Cierra la imagen antes de borrarla
+    std::remove(config.imagen.c_str());
+    return true;
+}
+
+} // namespace
+
+int experimento_imagen(const ConfiguracionSimulacion &config)
+{
+    std::cout << "Experimento: escrituras reales sobre una imagen de disco (pwritev"
+              << (config.directo ? ", O_DIRECT" : ", con page cache") << ")\n"
+              << "  Imagen: " << config.imagen << ", " << config.total_bloques << " bloques de "
+              << config.tamanio_bloque << " bytes, ocupación inicial " << config.ocupacion_inicial << "\n"
+              << "  " << OPERACIONES << " operaciones por estructura (allocar 1-64 bloques / liberar)\n\n";
+
+    std::cout << std::left << std::setw(25) << "Estructura"
+              << std::setw(10) << "MB"
+              << std::setw(10) << "pwritev"
+              << std::setw(13) << "bloq/llamada"
+              << std::setw(13) << "distancia"
+              << std::setw(11) << "I/O ms"
+              << std::setw(10) << "MB/s"
+              << "Fallos\n";
+    std::cout << std::string(98, '-') << "\n";
+
+    bool sin_errores = true;
+    for (size_t g = 0; g < NUM_ESTRUCTURAS; g++)
+    {
+        ResultadoImagen r;
+        if (!correr_imagen(config, g, r))
+            return 1;
+
+        std::cout << std::left << std::setw(25) << r.estructura
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(10) << r.megabytes
+                  << std::setw(10) << r.llamadas
+                  << std::setw(13) << r.bloques_por_llamada
+                  << std::setprecision(0)
+                  << std::setw(13) << r.distancia_media
+                  << std::setprecision(1)
+                  << std::setw(11) << r.io_ms
+                  << std::setw(10) << r.megabytes_por_segundo
+                  << r.fallos
+                  << (r.errores ? "  ¡ERRORES DE ESCRITURA!" : "") << "\n";
+        sin_errores = sin_errores && r.errores == 0;
+    }
+
+    std::cout << "\ndistancia = bloques saltados en promedio entre una escritura y la siguiente\n";
+    return sin_errores ? 0 : 1;
+}
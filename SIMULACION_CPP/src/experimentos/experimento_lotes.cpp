@@ -0,0 +1,138 @@
+/*
+ * experimento_lotes.cpp
+ *
+ * Modo --modo lotes: cuánto tiempo de CPU ahorran allocar_lote /
+ * liberar_lote frente a la misma ráfaga atendida llamada por llamada.
+ *
+ * CARGA:
+ * - Dos copias de cada estructura llenadas con llenar_disco() y la misma
+ *   semilla (mismo estado inicial)
+ * - NUM_RAFAGAS ráfagas: liberar `tamanio_lote` extensiones vivas
+ *   elegidas al azar y después allocar `tamanio_lote` pedidos de 1-32
+ *   bloques. Una copia usa liberar()/allocar() en el orden de llegada,
+ *   la otra los lotes.
+ *
+ * Los lotes deben dar exactamente las mismas posiciones (columna
+ * "Iguales"): así ambas copias siguen viendo las mismas ráfagas.
+ *
+ * Sirve con discos grandes, donde las listas tienen miles de nodos:
+ *   ./simulador_disco --modo lotes --bloques 1000000 --lote 2000
+ */
+
+#include "experimentos.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+
+const int NUM_RAFAGAS = 20;
+const unsigned SEMILLA = 4242;
+
+struct ResultadoLotes
+{
+    double cpu_ms = 0.0;                   // Solo las operaciones de las ráfagas
+    std::vector<IndiceBloque> posiciones; // Resultado de cada allocación
+};
+
+ResultadoLotes correr_rafagas(const ConfiguracionSimulacion &config, size_t indice_gestor, bool por_lotes)
+{
+    auto gestores = crear_gestores(config.total_bloques, config.tamanio_bloque);
+    GestorDisco &gestor = *gestores[indice_gestor];
+    gestor.set_dispositivo(crear_modelo_dispositivo(config.dispositivo, config.tamanio_bloque));
+
+    std::mt19937 gen(SEMILLA);
+    ExtensionesVivas vivas;
+    llenar_disco(gestor, config.ocupacion_inicial, gen, vivas);
+
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32);
+    ResultadoLotes resultado;
+
+    for (int rafaga = 0; rafaga < NUM_RAFAGAS; rafaga++)
+    {
+        // Armar la ráfaga fuera del cronómetro
+        std::vector<Extension> liberaciones;
+        for (int i = 0; i < config.tamanio_lote && !vivas.empty(); i++)
+        {
+            std::uniform_int_distribution<size_t> dist_indice(0, vivas.size() - 1);
+            size_t k = dist_indice(gen);
+            liberaciones.push_back(vivas[k]);
+            vivas[k] = vivas.back();
+            vivas.pop_back();
+        }
+
+        std::vector<IndiceBloque> pedidos;
+        for (int i = 0; i < config.tamanio_lote; i++)
+            pedidos.push_back(dist_tam(gen));
+
+        auto comienzo = std::chrono::steady_clock::now();
+
+        std::vector<IndiceBloque> posiciones;
+        if (por_lotes)
+        {
+            gestor.liberar_lote(liberaciones);
+            posiciones = gestor.allocar_lote(pedidos);
+        }
+        else
+        {
+            for (const Extension &extension : liberaciones)
+                gestor.liberar(extension.first, extension.second);
+            for (IndiceBloque tamanio : pedidos)
+                posiciones.push_back(gestor.allocar(tamanio));
+        }
+
+        auto fin = std::chrono::steady_clock::now();
+        resultado.cpu_ms += std::chrono::duration<double, std::milli>(fin - comienzo).count();
+
+        for (size_t i = 0; i < pedidos.size(); i++)
+        {
+            if (posiciones[i] != -1)
+                vivas.push_back({posiciones[i], pedidos[i]});
+        }
+        resultado.posiciones.insert(resultado.posiciones.end(), posiciones.begin(), posiciones.end());
+    }
+
+    return resultado;
+}
+
+} // namespace
+
+int experimento_lotes(const ConfiguracionSimulacion &config)
+{
+    size_t num_gestores = crear_gestores(1).size();
+
+    std::cout << "Experimento: operaciones por lotes vs una llamada por extensión\n"
+              << "  Disco: " << config.total_bloques << " bloques, " << NUM_RAFAGAS
+              << " ráfagas de " << config.tamanio_lote << " liberaciones + "
+              << config.tamanio_lote << " allocaciones\n"
+              << "  Tiempos en ms de CPU (solo las ráfagas)\n\n";
+
+    std::cout << std::left << std::setw(25) << "Estructura"
+              << std::setw(14) << "Uno a uno"
+              << std::setw(14) << "Lotes"
+              << std::setw(12) << "Ganancia"
+              << "Iguales\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    bool todas_iguales = true;
+    for (size_t g = 0; g < num_gestores; g++)
+    {
+        std::string nombre = crear_gestores(1)[g]->obtener_nombre();
+        ResultadoLotes uno_a_uno = correr_rafagas(config, g, false);
+        ResultadoLotes lotes = correr_rafagas(config, g, true);
+        bool iguales = uno_a_uno.posiciones == lotes.posiciones;
+        todas_iguales = todas_iguales && iguales;
+
+        std::cout << std::left << std::setw(25) << nombre
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << uno_a_uno.cpu_ms
+                  << std::setw(14) << lotes.cpu_ms
+                  << std::setprecision(2)
+                  << std::setw(12) << (lotes.cpu_ms > 0.0 ? uno_a_uno.cpu_ms / lotes.cpu_ms : 0.0)
+                  << (iguales ? "sí" : "NO") << "\n";
+    }
+
+    std::cout << "\nGanancia = CPU uno a uno / CPU por lotes\n";
+    return todas_iguales ? 0 : 1;
+}
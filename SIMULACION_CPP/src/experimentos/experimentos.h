@@ -0,0 +1,103 @@
+/*
+ * experimentos.h
+ *
+ * Configuración compartida y modos de experimento que `main` despacha
+ * con --modo. La simulación principal (5 corridas) sigue en main.cpp;
+ * cada experimento vive en su propio archivo de esta carpeta.
+ */
+
+#ifndef EXPERIMENTOS_H
+#define EXPERIMENTOS_H
+
+#include "core/disk_manager.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Rango de tamaños pedidos: {mínimo, máximo} bloques
+typedef std::pair<IndiceBloque, IndiceBloque> RangoTamanios;
+
+// Estructura: ConfiguracionSimulacion
+// Geometría del disco y parámetros del experimento (ajustables por línea
+// de comandos para medir cómo escala cada estructura).
+
+struct ConfiguracionSimulacion
+{
+    IndiceBloque total_bloques = TOTAL_BLOQUES;
+    int tamanio_bloque = TAMANIO_BLOQUE;
+    float ocupacion_inicial = OCUPACION_INICIAL;
+    std::string dispositivo = "hdd";  // Modelo de costo de I/O: hdd, ssd, nulo
+    std::string modo = "simulacion";  // simulacion, cola, lotes, concurrente, atomico, reproducir, barrido, diario, imagen, asincrono
+    int profundidad_cola = 32;        // Peticiones en vuelo por lote (cola); máximo en asincrono
+    int tamanio_lote = 1000;          // Operaciones por ráfaga (modo lotes)
+    int hilos = 4;                    // Pool de la simulación; máximo en concurrente, atomico y diario
+    uint32_t semilla = 0;             // Semilla base de la simulación (0 = al azar)
+    std::string traza;                // Simulación: grabar aquí; reproducir: leer de aquí
+    std::string estado_inicial;       // Estado del disco antes de reproducir (vacío = disco libre)
+
+    // Rejilla del modo barrido: se corre cada combinación
+    std::vector<IndiceBloque> barrido_bloques = {16384, 262144};
+    std::vector<float> barrido_ocupaciones = {0.5f, 0.7f, 0.9f};
+    std::vector<RangoTamanios> barrido_tamanios = {{1, 32}, {1, 256}};
+    std::vector<int> barrido_operaciones = {1000, 10000};
+    std::string salida = "data/barrido.csv"; // Terminado en .json → JSON; si no, CSV
+
+    std::string imagen = "data/disco.img"; // Archivo imagen (modos imagen y asincrono)
+    bool directo = false;                  // Abrir la imagen con O_DIRECT
+};
+
+// Extensiones ocupadas por el experimento: {inicio, tamaño}
+typedef std::vector<Extension> ExtensionesVivas;
+
+// Llevar un gestor a la ocupación pedida usando solo su propia API:
+// llenarlo con allocaciones de 1-32 bloques hasta que no entre más y
+// liberar extensiones al azar hasta bajar a `ocupacion`. Deja huecos
+// repartidos por todo el disco. Las extensiones que quedan ocupadas se
+// devuelven en `vivas`.
+void llenar_disco(GestorDisco &gestor, float ocupacion, std::mt19937 &gen,
+                  ExtensionesVivas &vivas);
+
+// MODOS (retornan el código de salida del programa)
+
+// Cola con planificador de ascensor: FIFO vs SCAN vs C-LOOK por estructura
+int experimento_cola(const ConfiguracionSimulacion &config);
+
+// allocar_lote / liberar_lote vs llamadas individuales, por estructura
+// (retorna 1 si algún lote no dio las mismas posiciones)
+int experimento_lotes(const ConfiguracionSimulacion &config);
+
+// Escritores concurrentes sobre GestorConcurrente: escalado de 1 a
+// config.hilos (retorna 1 si algún volumen quedó inconsistente)
+int experimento_concurrente(const ConfiguracionSimulacion &config);
+
+// Contención: MapaDeBitsAtomico vs MapaDeBits con un mutex, de 1 a
+// config.hilos (latencia de allocación por percentiles)
+int experimento_atomico(const ConfiguracionSimulacion &config);
+
+// Reproducir config.traza sobre todas las estructuras, desde el mismo
+// estado inicial, a máxima velocidad (retorna 1 si la traza no se lee)
+int experimento_reproducir(const ConfiguracionSimulacion &config);
+
+// Todas las estructuras sobre cada celda de la rejilla barrido_*; una
+// fila por celda y estructura en config.salida (retorna 1 si no se
+// puede escribir)
+int experimento_barrido(const ConfiguracionSimulacion &config);
+
+// Diario de escritura anticipada: fsync por operación vs commit en grupo,
+// de 1 a config.hilos, y recuperación tras un final cortado (retorna 1
+// si algún estado recuperado no coincide)
+int experimento_diario(const ConfiguracionSimulacion &config);
+
+// Misma carga sobre todas las estructuras con escrituras reales en
+// config.imagen (pwritev por extensión): throughput según las posiciones
+// que elige cada una (retorna 1 si la imagen no se abre o falla una escritura)
+int experimento_imagen(const ConfiguracionSimulacion &config);
+
+// I/O asíncrono (io_uring o hilos) sobre la disposición que dejan
+// MapaDeBits y las listas: MB/s de 1 a config.profundidad_cola peticiones
+// en vuelo (retorna 1 si falla la imagen, el motor o alguna transferencia)
+int experimento_asincrono(const ConfiguracionSimulacion &config);
+
+#endif // EXPERIMENTOS_H
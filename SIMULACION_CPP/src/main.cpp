@@ -7,13 +7,22 @@
  */
 
 #include "core/disk_manager.h"
+#include "core/histograma_latencia.h"
+#include "core/pool_hilos.h"
+#include "core/traza.h"
+#include "experimentos/experimentos.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <future>
 #include <vector>
 #include <random>
 #include <iomanip>
 #include <memory>
 #include <map>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
 
 // Estructura: ResultadoOperacion
 // Guarda el resultado de una operación (allocar o liberar)
@@ -24,74 +33,88 @@ struct ResultadoOperacion
     bool exito;          // ¿Se completó exitosamente?
 };
 
-// Estructura: ResultadoEstructura
-// Guarda los resultados de una estructura en una corrida
+// Función: promedio
+// Promedio de un vector de tiempos (0 si está vacío)
 
-struct ResultadoEstructura
+template <typename T>
+double promedio(const std::vector<T> &valores)
 {
-    std::string nombre;                        // "Mapa de Bits", etc.
-    std::vector<long long> tiempos_allocacion; // Vector con 50 tiempos
-    std::vector<long long> tiempos_liberacion; // Vector con 30 tiempos
-    long long tiempo_busqueda;                 // Un solo tiempo
-    float fragmentacion;                       // Porcentaje
+    if (valores.empty())
+        return 0.0;
+    double suma = 0;
+    for (auto v : valores)
+        suma += v;
+    return suma / valores.size();
+}
 
-    // Calcular promedio de allocaciones
-    double promedio_allocacion() const
-    {
-        if (tiempos_allocacion.empty())
-            return 0.0;
-        long long suma = 0;
-        for (auto t : tiempos_allocacion)
-            suma += t;
-        return static_cast<double>(suma) / tiempos_allocacion.size();
-    }
+// Estructura: ResultadoEstructura
+// Guarda los resultados de una estructura en una corrida.
+// Dos relojes: CPU real (ns, en histogramas por tipo de operación: lo
+// que cuesta la estructura) y dispositivo simulado (ms, lo que tardaría
+// el disco según el modelo elegido).
 
-    // Calcular promedio de liberaciones
-    double promedio_liberacion() const
-    {
-        if (tiempos_liberacion.empty())
-            return 0.0;
-        long long suma = 0;
-        for (auto t : tiempos_liberacion)
-            suma += t;
-        return static_cast<double>(suma) / tiempos_liberacion.size();
-    }
+struct ResultadoEstructura
+{
+    std::string nombre;                           // "Mapa de Bits", etc.
+    HistogramaLatencia latencia_allocacion;       // CPU (ns), hasta 50 muestras
+    HistogramaLatencia latencia_liberacion;       // CPU (ns), hasta 30 muestras
+    std::vector<double> dispositivo_allocacion;   // Dispositivo (ms)
+    std::vector<double> dispositivo_liberacion;   // Dispositivo (ms)
+    long long tiempo_busqueda;                    // CPU (ns), un solo tiempo
+    float fragmentacion;                          // Porcentaje
+    double nodos_por_liberacion;                  // Recorrido promedio (listas)
+    std::vector<IndiceBloque> decisiones;         // Inicio de cada allocación (-1 si falló) y liberación, en orden
+    std::string registro;                         // Progreso impreso por la tarea
+
+    double promedio_allocacion() const { return latencia_allocacion.get_media(); }
+    double promedio_liberacion() const { return latencia_liberacion.get_media(); }
+    double promedio_dispositivo_allocacion() const { return promedio(dispositivo_allocacion); }
+    double promedio_dispositivo_liberacion() const { return promedio(dispositivo_liberacion); }
 };
 
 // Función: ejecutar_secuencia_pruebas
 // Ejecuta la secuencia completa de pruebas para una estructura.
 // Proceso: 50 allocaciones, 30 liberaciones, 1 búsqueda, calcular fragmentación.
+// Misma semilla → mismos tamaños y mismas víctimas. El progreso se
+// escribe en `salida` (cada tarea en paralelo tiene la suya). Con
+// `grabador`, cada operación queda además en la traza.
 
-ResultadoEstructura ejecutar_secuencia_pruebas(GestorDisco *gestor)
+ResultadoEstructura ejecutar_secuencia_pruebas(GestorDisco *gestor, uint32_t semilla, std::ostream &salida,
+                                               GrabadorTraza *grabador = nullptr)
 {
     ResultadoEstructura resultado;
     resultado.nombre = gestor->obtener_nombre();
 
     // Generadores aleatorios
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist_tam(1, 32); // Tamaño 1-32
-    std::uniform_int_distribution<> dist_bloque(0, TOTAL_BLOQUES - 1);
+    std::mt19937 gen(semilla);
+    std::uniform_int_distribution<IndiceBloque> dist_tam(1, 32); // Tamaño 1-32
 
     // Para rastrear allocaciones exitosas (para liberar después)
-    std::vector<std::pair<int, int>> allocaciones_exitosas; // {inicio, tamaño}
+    std::vector<std::pair<IndiceBloque, IndiceBloque>> allocaciones_exitosas; // {inicio, tamaño}
 
-    std::cout << "  Ejecutando 50 allocaciones...\n";
+    salida << "  Ejecutando 50 allocaciones...\n";
 
     // Fase 1: 50 allocaciones
     for (int i = 0; i < 50; i++)
     {
-        int num_bloques = dist_tam(gen); // Tamaño aleatorio 1-32
+        IndiceBloque num_bloques = dist_tam(gen); // Tamaño aleatorio 1-32
 
-        // Medir tiempo
+        // Medir tiempo (CPU real y reloj del dispositivo)
+        double reloj_antes = gestor->get_tiempo_virtual_us();
         gestor->iniciar_cronometro();
-        int inicio_real = gestor->allocar(num_bloques);
+        IndiceBloque inicio_real = gestor->allocar(num_bloques);
         long long tiempo = gestor->detener_cronometro();
+        double tiempo_dispositivo = (gestor->get_tiempo_virtual_us() - reloj_antes) / 1000.0;
+
+        resultado.decisiones.push_back(inicio_real);
+        if (grabador)
+            grabador->grabar(ALLOCACION, inicio_real, num_bloques);
 
         // Guardar tiempo (solo si fue exitoso)
         if (inicio_real != -1)
         {
-            resultado.tiempos_allocacion.push_back(tiempo);
+            resultado.latencia_allocacion.registrar(tiempo);
+            resultado.dispositivo_allocacion.push_back(tiempo_dispositivo);
             // Guardar la posición real para liberarla después
             allocaciones_exitosas.push_back({inicio_real, num_bloques});
         }
@@ -99,30 +122,37 @@ ResultadoEstructura ejecutar_secuencia_pruebas(GestorDisco *gestor)
         // Progreso cada 10 operaciones
         if ((i + 1) % 10 == 0)
         {
-            std::cout << "    Allocación " << (i + 1) << "/50 completada\n";
+            salida << "    Allocación " << (i + 1) << "/50 completada\n";
         }
     }
 
-    std::cout << "  Ejecutando 30 liberaciones...\n";
+    salida << "  Ejecutando 30 liberaciones...\n";
 
     // Fase 2: 30 liberaciones
     int liberaciones_realizadas = 0;
     for (int i = 0; i < 30 && !allocaciones_exitosas.empty(); i++)
     {
         // Seleccionar una allocación aleatoria para liberar
-        std::uniform_int_distribution<> dist_alloc(0, allocaciones_exitosas.size() - 1);
-        int index = dist_alloc(gen);
+        std::uniform_int_distribution<size_t> dist_alloc(0, allocaciones_exitosas.size() - 1);
+        size_t index = dist_alloc(gen);
 
         auto [inicio, tamanio] = allocaciones_exitosas[index];
+        resultado.decisiones.push_back(inicio);
 
-        // Medir tiempo
+        // Medir tiempo (CPU real y reloj del dispositivo)
+        double reloj_antes = gestor->get_tiempo_virtual_us();
         gestor->iniciar_cronometro();
         bool exito = gestor->liberar(inicio, tamanio);
         long long tiempo = gestor->detener_cronometro();
+        double tiempo_dispositivo = (gestor->get_tiempo_virtual_us() - reloj_antes) / 1000.0;
+
+        if (grabador)
+            grabador->grabar(LIBERACION, inicio, tamanio);
 
         if (exito)
         {
-            resultado.tiempos_liberacion.push_back(tiempo);
+            resultado.latencia_liberacion.registrar(tiempo);
+            resultado.dispositivo_liberacion.push_back(tiempo_dispositivo);
             // Remover de la lista (ya fue liberado)
             allocaciones_exitosas.erase(allocaciones_exitosas.begin() + index);
             liberaciones_realizadas++;
@@ -130,25 +160,40 @@ ResultadoEstructura ejecutar_secuencia_pruebas(GestorDisco *gestor)
 
         if ((i + 1) % 10 == 0)
         {
-            std::cout << "    Liberación " << (i + 1) << "/30 completada\n";
+            salida << "    Liberación " << (i + 1) << "/30 completada\n";
         }
     }
 
-    std::cout << "  Midiendo búsqueda del bloque más grande...\n";
+    salida << "  Midiendo búsqueda del bloque más grande...\n";
 
     // Fase 3: búsqueda
     gestor->iniciar_cronometro();
-    int bloque_mayor = gestor->buscar_bloque_mas_grande();
+    IndiceBloque bloque_mayor = gestor->buscar_bloque_mas_grande();
     resultado.tiempo_busqueda = gestor->detener_cronometro();
+    if (grabador)
+        grabador->grabar(BUSQUEDA, -1, 0);
 
-    std::cout << "    Bloque libre más grande: " << bloque_mayor << " bloques\n";
+    salida << "    Bloque libre más grande: " << bloque_mayor << " bloques\n";
 
     // Fase 4: fragmentación
     resultado.fragmentacion = gestor->get_fragmentacion();
+    resultado.nodos_por_liberacion = gestor->get_nodos_por_liberacion();
 
     return resultado;
 }
 
+// Función: escribir_percentiles
+// Una línea "p50 … p90 … p99 … p99.9 … max …" (ns) de un histograma
+
+void escribir_percentiles(std::ostream &salida, const HistogramaLatencia &histograma)
+{
+    salida << "p50 " << histograma.percentil(0.50)
+           << "  p90 " << histograma.percentil(0.90)
+           << "  p99 " << histograma.percentil(0.99)
+           << "  p99.9 " << histograma.percentil(0.999)
+           << "  max " << histograma.get_maximo();
+}
+
 // Función: guardar_resultados
 // Escribir resultados de una corrida en resultados.txt
 
@@ -171,12 +216,24 @@ void guardar_resultados(const std::vector<ResultadoEstructura> &resultados,
     {
         file << "Estructura: " << res.nombre << "\n";
         file << "  Allocación promedio: " << std::fixed << std::setprecision(2)
-             << res.promedio_allocacion() << " ms\n";
-        file << "  Liberación promedio: " << res.promedio_liberacion() << " ms\n";
-        file << "  Búsqueda bloque grande: " << res.tiempo_busqueda << " ms\n";
+             << res.promedio_allocacion() << " ns CPU, "
+             << res.promedio_dispositivo_allocacion() << " ms dispositivo\n";
+        file << "    Latencia CPU (ns): ";
+        escribir_percentiles(file, res.latencia_allocacion);
+        file << "\n";
+        file << "  Liberación promedio: " << res.promedio_liberacion() << " ns CPU, "
+             << res.promedio_dispositivo_liberacion() << " ms dispositivo\n";
+        file << "    Latencia CPU (ns): ";
+        escribir_percentiles(file, res.latencia_liberacion);
+        file << "\n";
+        file << "  Búsqueda bloque grande: " << res.tiempo_busqueda << " ns CPU\n";
         file << "  Fragmentación: " << res.fragmentacion << "%\n";
-        file << "  Allocaciones exitosas: " << res.tiempos_allocacion.size() << "/50\n";
-        file << "  Liberaciones exitosas: " << res.tiempos_liberacion.size() << "/30\n";
+        file << "  Allocaciones exitosas: " << res.latencia_allocacion.get_cuenta() << "/50\n";
+        file << "  Liberaciones exitosas: " << res.latencia_liberacion.get_cuenta() << "/30\n";
+        if (res.nodos_por_liberacion > 0.0)
+        {
+            file << "  Nodos visitados por liberación: " << res.nodos_por_liberacion << "\n";
+        }
         file << "\n";
     }
 
@@ -184,7 +241,8 @@ void guardar_resultados(const std::vector<ResultadoEstructura> &resultados,
 }
 
 // Función: imprimir_resumen_final
-// Muestra la tabla comparativa con promedios de las corridas.
+// Muestra la tabla comparativa con promedios de las corridas y la cola
+// de latencia de CPU (histogramas de las corridas combinados).
 
 void imprimir_resumen_final(const std::vector<std::vector<ResultadoEstructura>> &todas_corridas)
 {
@@ -193,8 +251,12 @@ void imprimir_resumen_final(const std::vector<std::vector<ResultadoEstructura>>
     // Acumular datos por estructura
     std::map<std::string, std::vector<double>> promedios_alloc;
     std::map<std::string, std::vector<double>> promedios_lib;
+    std::map<std::string, std::vector<double>> dispositivo_alloc;
+    std::map<std::string, std::vector<double>> dispositivo_lib;
     std::map<std::string, std::vector<long long>> tiempos_busq;
     std::map<std::string, std::vector<float>> fragmentaciones;
+    std::map<std::string, HistogramaLatencia> latencias_alloc;
+    std::map<std::string, HistogramaLatencia> latencias_lib;
 
     // Recolectar datos de todas las corridas
     for (const auto &corrida : todas_corridas)
@@ -203,127 +265,492 @@ void imprimir_resumen_final(const std::vector<std::vector<ResultadoEstructura>>
         {
             promedios_alloc[res.nombre].push_back(res.promedio_allocacion());
             promedios_lib[res.nombre].push_back(res.promedio_liberacion());
+            dispositivo_alloc[res.nombre].push_back(res.promedio_dispositivo_allocacion());
+            dispositivo_lib[res.nombre].push_back(res.promedio_dispositivo_liberacion());
             tiempos_busq[res.nombre].push_back(res.tiempo_busqueda);
             fragmentaciones[res.nombre].push_back(res.fragmentacion);
+            latencias_alloc[res.nombre].combinar(res.latencia_allocacion);
+            latencias_lib[res.nombre].combinar(res.latencia_liberacion);
         }
     }
 
     // Imprimir tabla
+    // CPU en ns (costo de la estructura), Disp en ms (reloj simulado)
     std::cout << std::left << std::setw(25) << "Estructura"
-              << std::setw(15) << "Alloc (ms)"
-              << std::setw(15) << "Liber (ms)"
-              << std::setw(15) << "Búsq (ms)"
-              << std::setw(12) << "Frag (%)\n";
-    std::cout << std::string(82, '-') << "\n";
+              << std::setw(16) << "Alloc CPU(ns)"
+              << std::setw(16) << "Alloc Disp(ms)"
+              << std::setw(16) << "Liber CPU(ns)"
+              << std::setw(16) << "Liber Disp(ms)"
+              << std::setw(17) << "Búsq CPU(ns)" // setw cuenta bytes: ú ocupa 2
+              << "Frag (%)\n";
+    std::cout << std::string(113, '-') << "\n";
 
     for (const auto &[nombre, tiempos] : promedios_alloc)
     {
         // Calcular promedios de las 5 corridas
-        double avg_alloc = 0, avg_lib = 0, avg_busq = 0, avg_frag = 0;
-
-        for (double t : tiempos)
-            avg_alloc += t;
-        avg_alloc /= tiempos.size();
-
-        for (double t : promedios_lib[nombre])
-            avg_lib += t;
-        avg_lib /= promedios_lib[nombre].size();
-
-        for (long long t : tiempos_busq[nombre])
-            avg_busq += t;
-        avg_busq /= tiempos_busq[nombre].size();
-
-        for (float f : fragmentaciones[nombre])
-            avg_frag += f;
-        avg_frag /= fragmentaciones[nombre].size();
+        double avg_alloc = promedio(tiempos);
+        double avg_lib = promedio(promedios_lib[nombre]);
+        double avg_disp_alloc = promedio(dispositivo_alloc[nombre]);
+        double avg_disp_lib = promedio(dispositivo_lib[nombre]);
+        double avg_busq = promedio(tiempos_busq[nombre]);
+        double avg_frag = promedio(fragmentaciones[nombre]);
 
         // Imprimir fila
         std::cout << std::left << std::setw(25) << nombre
                   << std::fixed << std::setprecision(2)
-                  << std::setw(15) << avg_alloc
-                  << std::setw(15) << avg_lib
-                  << std::setw(15) << avg_busq
-                  << std::setw(12) << avg_frag << "\n";
+                  << std::setw(16) << avg_alloc
+                  << std::setw(16) << avg_disp_alloc
+                  << std::setw(16) << avg_lib
+                  << std::setw(16) << avg_disp_lib
+                  << std::setw(16) << avg_busq
+                  << avg_frag << "\n";
+    }
+
+    // Cola de latencia: los promedios esconden los picos
+    std::cout << "\nLatencia de CPU por operación (ns, " << todas_corridas.size()
+              << " corridas combinadas)\n\n";
+    std::cout << std::left << std::setw(25) << "Estructura"
+              << std::setw(12) << "Operación" // ó ocupa 2 bytes
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p90"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9"
+              << std::setw(10) << "max"
+              << "Muestras\n";
+    std::cout << std::string(104, '-') << "\n";
+
+    for (const auto &[nombre, histograma_alloc] : latencias_alloc)
+    {
+        const std::pair<const char *, const HistogramaLatencia *> filas[] = {
+            {"allocar", &histograma_alloc}, {"liberar", &latencias_lib[nombre]}};
+
+        for (const auto &[operacion, histograma] : filas)
+        {
+            std::cout << std::left << std::setw(25) << nombre
+                      << std::setw(11) << operacion
+                      << std::setw(10) << histograma->percentil(0.50)
+                      << std::setw(10) << histograma->percentil(0.90)
+                      << std::setw(10) << histograma->percentil(0.99)
+                      << std::setw(10) << histograma->percentil(0.999)
+                      << std::setw(10) << histograma->get_maximo()
+                      << histograma->get_cuenta() << "\n";
+        }
     }
 
     std::cout << "\n";
 }
 
+// Función: semilla_de_corrida
+// Semilla de las tareas de una corrida, derivada de la semilla base.
+// Todas las estructuras de una corrida reciben la misma: ven los mismos
+// tamaños pedidos.
+
+uint32_t semilla_de_corrida(uint32_t semilla_base, int corrida)
+{
+    std::seed_seq secuencia{semilla_base, static_cast<uint32_t>(corrida)};
+    uint32_t semilla;
+    secuencia.generate(&semilla, &semilla + 1);
+    return semilla;
+}
+
+// Función: correr_corridas
+// Reparte los pares (corrida, estructura) en un pool de `num_hilos`.
+// Cada tarea crea su gestor, copia el estado de `plantilla` y ejecuta la
+// secuencia con la semilla de su corrida. Los resultados se devuelven en
+// el orden de siempre, sin importar qué tarea terminó primero.
+// Con `grabador`, la tarea (corrida 1, primera estructura) graba su traza.
+
+std::vector<std::vector<ResultadoEstructura>> correr_corridas(const ConfiguracionSimulacion &config,
+                                                              const GestorDisco &plantilla,
+                                                              uint32_t semilla_base, int num_corridas,
+                                                              size_t num_hilos,
+                                                              GrabadorTraza *grabador = nullptr)
+{
+    PoolHilos pool(num_hilos);
+    std::vector<std::vector<std::future<ResultadoEstructura>>> futuros(num_corridas);
+
+    for (int corrida = 1; corrida <= num_corridas; corrida++)
+    {
+        uint32_t semilla = semilla_de_corrida(semilla_base, corrida);
+
+        for (size_t indice = 0; indice < NUM_ESTRUCTURAS; indice++)
+        {
+            GrabadorTraza *grabador_tarea = (corrida == 1 && indice == 0) ? grabador : nullptr;
+
+            futuros[corrida - 1].push_back(pool.enviar([&config, &plantilla, indice, semilla, grabador_tarea]
+            {
+                auto gestor = crear_gestor(indice, config.total_bloques, config.tamanio_bloque);
+                gestor->set_dispositivo(crear_modelo_dispositivo(config.dispositivo, config.tamanio_bloque));
+                gestor->copiar_estado(plantilla);
+
+                std::ostringstream registro;
+                ResultadoEstructura resultado = ejecutar_secuencia_pruebas(gestor.get(), semilla, registro,
+                                                                          grabador_tarea);
+                resultado.registro = registro.str();
+                return resultado;
+            }));
+        }
+    }
+
+    std::vector<std::vector<ResultadoEstructura>> todas_corridas(num_corridas);
+    for (int c = 0; c < num_corridas; c++)
+    {
+        for (auto &futuro : futuros[c])
+            todas_corridas[c].push_back(futuro.get());
+    }
+    return todas_corridas;
+}
+
+// Función: contar_diferencias
+// Compara dos ejecuciones de las mismas tareas: mismas decisiones de
+// allocación/liberación y misma fragmentación final.
+// Retorna: cuántas tareas difieren (debe ser 0)
+
+int contar_diferencias(const std::vector<std::vector<ResultadoEstructura>> &a,
+                       const std::vector<std::vector<ResultadoEstructura>> &b)
+{
+    int diferencias = 0;
+    for (size_t c = 0; c < a.size(); c++)
+    {
+        for (size_t e = 0; e < a[c].size(); e++)
+        {
+            if (a[c][e].decisiones != b[c][e].decisiones || a[c][e].fragmentacion != b[c][e].fragmentacion)
+            {
+                std::cout << "  Corrida " << (c + 1) << ", " << a[c][e].nombre << ": decisiones distintas\n";
+                diferencias++;
+            }
+        }
+    }
+    return diferencias;
+}
+
+// Función: leer_lista
+// Lista separada por comas ("16384,262144"); cada elemento se lee con
+// `convertir(texto, valor)`.
+// Retorna false si algún elemento es inválido o la lista queda vacía.
+
+template <typename T, typename Convertir>
+bool leer_lista(const char *texto, std::vector<T> &valores, Convertir convertir)
+{
+    valores.clear();
+    std::stringstream entrada(texto);
+    std::string elemento;
+    while (std::getline(entrada, elemento, ','))
+    {
+        T valor;
+        if (!convertir(elemento, valor))
+            return false;
+        valores.push_back(valor);
+    }
+    return !valores.empty();
+}
+
+// Número completo (sin basura al final), positivo
+template <typename T>
+bool leer_numero(const std::string &texto, T &valor)
+{
+    char *fin = nullptr;
+    double numero = std::strtod(texto.c_str(), &fin);
+    valor = static_cast<T>(numero);
+    return !texto.empty() && *fin == '\0' && numero > 0;
+}
+
+// Rango "MIN-MAX" con 1 <= MIN <= MAX
+bool leer_rango(const std::string &texto, RangoTamanios &rango)
+{
+    size_t guion = texto.find('-');
+    return guion != std::string::npos &&
+           leer_numero(texto.substr(0, guion), rango.first) &&
+           leer_numero(texto.substr(guion + 1), rango.second) &&
+           rango.first <= rango.second;
+}
+
+// Función: leer_configuracion
+// Opciones: --bloques N  --tamanio-bloque BYTES  --ocupacion FRACCION
+//           --dispositivo hdd|ssd|nulo
+//           --modo simulacion|cola|lotes|concurrente|atomico|reproducir|barrido|diario|imagen|asincrono
+//           --profundidad N (peticiones por lote en cola; máximo en vuelo en asincrono)
+//           --lote N (operaciones por ráfaga en el modo lotes)
+//           --hilos N (pool de la simulación; máximo en concurrente, atomico y diario)
+//           --semilla N (0 = al azar; la simulación informa la usada)
+//           --traza ARCHIVO (simulación: dónde grabar; reproducir: qué leer)
+//           --estado ARCHIVO (reproducir: estado inicial del disco)
+//           --barrido-bloques N,N  --barrido-ocupacion F,F
+//           --barrido-tamanios MIN-MAX,MIN-MAX  --barrido-ops N,N
+//           --salida ARCHIVO (barrido: .csv o .json)
+//           --imagen ARCHIVO  --directo 0|1 (imagen y asincrono: archivo y O_DIRECT)
+// Retorna false si hay una opción desconocida o un valor inválido.
+
+bool leer_configuracion(int argc, char *argv[], ConfiguracionSimulacion &config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string opcion = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Falta el valor de la opción " << opcion << "\n";
+            return false;
+        }
+        const char *valor = argv[++i];
+
+        if (opcion == "--bloques")
+            config.total_bloques = std::strtoll(valor, nullptr, 10);
+        else if (opcion == "--tamanio-bloque")
+            config.tamanio_bloque = std::atoi(valor);
+        else if (opcion == "--ocupacion")
+            config.ocupacion_inicial = std::strtof(valor, nullptr);
+        else if (opcion == "--dispositivo")
+            config.dispositivo = valor;
+        else if (opcion == "--modo")
+            config.modo = valor;
+        else if (opcion == "--profundidad")
+            config.profundidad_cola = std::atoi(valor);
+        else if (opcion == "--lote")
+            config.tamanio_lote = std::atoi(valor);
+        else if (opcion == "--hilos")
+            config.hilos = std::atoi(valor);
+        else if (opcion == "--semilla")
+            config.semilla = static_cast<uint32_t>(std::strtoul(valor, nullptr, 10));
+        else if (opcion == "--traza")
+            config.traza = valor;
+        else if (opcion == "--estado")
+            config.estado_inicial = valor;
+        else if (opcion == "--barrido-bloques" || opcion == "--barrido-ocupacion" ||
+                 opcion == "--barrido-tamanios" || opcion == "--barrido-ops")
+        {
+            bool valida;
+            if (opcion == "--barrido-bloques")
+                valida = leer_lista(valor, config.barrido_bloques, leer_numero<IndiceBloque>);
+            else if (opcion == "--barrido-ocupacion")
+                valida = leer_lista(valor, config.barrido_ocupaciones, leer_numero<float>) &&
+                         *std::max_element(config.barrido_ocupaciones.begin(),
+                                           config.barrido_ocupaciones.end()) <= 1.0f;
+            else if (opcion == "--barrido-tamanios")
+                valida = leer_lista(valor, config.barrido_tamanios, leer_rango);
+            else
+                valida = leer_lista(valor, config.barrido_operaciones, leer_numero<int>);
+
+            if (!valida)
+            {
+                std::cerr << "Lista inválida para " << opcion << ": " << valor << "\n";
+                return false;
+            }
+        }
+        else if (opcion == "--salida")
+            config.salida = valor;
+        else if (opcion == "--imagen")
+            config.imagen = valor;
+        else if (opcion == "--directo")
+            config.directo = std::atoi(valor) != 0;
+        else
+        {
+            std::cerr << "Opción desconocida: " << opcion << "\n";
+            return false;
+        }
+    }
+
+    if (config.total_bloques <= 0 || config.tamanio_bloque <= 0 ||
+        config.ocupacion_inicial < 0.0f || config.ocupacion_inicial > 1.0f)
+    {
+        std::cerr << "Geometría inválida\n";
+        return false;
+    }
+    if (crear_modelo_dispositivo(config.dispositivo) == nullptr)
+    {
+        std::cerr << "Dispositivo desconocido: " << config.dispositivo << "\n";
+        return false;
+    }
+    if (config.modo != "simulacion" && config.modo != "cola" && config.modo != "lotes" &&
+        config.modo != "concurrente" && config.modo != "atomico" && config.modo != "reproducir" &&
+        config.modo != "barrido" && config.modo != "diario" && config.modo != "imagen" &&
+        config.modo != "asincrono")
+    {
+        std::cerr << "Modo desconocido: " << config.modo << "\n";
+        return false;
+    }
+    if (config.profundidad_cola <= 0)
+    {
+        std::cerr << "Profundidad de cola inválida\n";
+        return false;
+    }
+    if (config.tamanio_lote <= 0)
+    {
+        std::cerr << "Tamaño de lote inválido\n";
+        return false;
+    }
+    if (config.hilos <= 0)
+    {
+        std::cerr << "Cantidad de hilos inválida\n";
+        return false;
+    }
+    if (config.modo == "reproducir" && config.traza.empty())
+    {
+        std::cerr << "El modo reproducir necesita --traza\n";
+        return false;
+    }
+    if (config.directo && config.tamanio_bloque % 512 != 0)
+    {
+        std::cerr << "--directo necesita un tamaño de bloque múltiplo de 512\n";
+        return false;
+    }
+    return true;
+}
+
+// Discos más grandes que esto no se exportan además en texto (~2 bytes
+// por bloque contra 1/8 del binario)
+const IndiceBloque LIMITE_EXPORTAR_TEXTO = IndiceBloque(1) << 20;
+
 // Función principal
 
-int main()
+int main(int argc, char *argv[])
 {
+    ConfiguracionSimulacion config;
+    if (!leer_configuracion(argc, argv, config))
+    {
+        std::cerr << "Uso: " << argv[0]
+                  << " [--bloques N] [--tamanio-bloque BYTES] [--ocupacion 0.70]"
+                  << " [--dispositivo hdd|ssd|nulo] [--modo simulacion|cola|lotes|concurrente|atomico|reproducir|barrido|diario|imagen|asincrono]"
+                  << " [--profundidad N] [--lote N] [--hilos N] [--semilla N]"
+                  << " [--traza ARCHIVO] [--estado ARCHIVO]"
+                  << " [--barrido-bloques N,N] [--barrido-ocupacion F,F]"
+                  << " [--barrido-tamanios MIN-MAX,MIN-MAX] [--barrido-ops N,N] [--salida ARCHIVO]"
+                  << " [--imagen ARCHIVO] [--directo 0|1]\n";
+        return 1;
+    }
+
+    if (config.modo == "cola")
+    {
+        return experimento_cola(config);
+    }
+    if (config.modo == "lotes")
+    {
+        return experimento_lotes(config);
+    }
+    if (config.modo == "concurrente")
+    {
+        return experimento_concurrente(config);
+    }
+    if (config.modo == "atomico")
+    {
+        return experimento_atomico(config);
+    }
+    if (config.modo == "reproducir")
+    {
+        return experimento_reproducir(config);
+    }
+    if (config.modo == "barrido")
+    {
+        return experimento_barrido(config);
+    }
+    if (config.modo == "diario")
+    {
+        return experimento_diario(config);
+    }
+    if (config.modo == "imagen")
+    {
+        return experimento_imagen(config);
+    }
+    if (config.modo == "asincrono")
+    {
+        return experimento_asincrono(config);
+    }
+
     std::cout << "Simulador de gestión de espacio en disco duro - Comparación de estructuras\n\n";
 
     const int NUM_CORRIDAS = 5;
-    std::vector<std::vector<ResultadoEstructura>> todas_corridas;
+
+    // Semilla base: la pedida o una al azar (se informa para poder repetir)
+    uint32_t semilla = config.semilla != 0 ? config.semilla : std::random_device{}();
+    std::cout << "Semilla: " << semilla << " (repetir con --semilla " << semilla << ")\n";
+    std::cout << "Hilos de trabajo: " << config.hilos << "\n\n";
 
     // Limpiar archivo de resultados previo
     std::ofstream file_clear("data/resultados.txt");
     file_clear << "RESULTADOS DE SIMULACIÓN\n";
     file_clear << "Fecha: " << __DATE__ << " " << __TIME__ << "\n";
     file_clear << "Configuración:\n";
-    file_clear << "  - Total bloques: " << TOTAL_BLOQUES << "\n";
-    file_clear << "  - Tamaño bloque: " << TAMANIO_BLOQUE << " bytes\n";
-    file_clear << "  - Ocupación inicial: " << (OCUPACION_INICIAL * 100) << "%\n";
+    file_clear << "  - Total bloques: " << config.total_bloques << "\n";
+    file_clear << "  - Tamaño bloque: " << config.tamanio_bloque << " bytes\n";
+    file_clear << "  - Ocupación inicial: " << (config.ocupacion_inicial * 100) << "%\n";
+    file_clear << "  - Dispositivo simulado: " << config.dispositivo << "\n";
     file_clear << "  - Número de corridas: " << NUM_CORRIDAS << "\n";
+    file_clear << "  - Semilla: " << semilla << "\n";
     file_clear.close();
 
+    // Un estado inicial único para todas las corridas y estructuras
+    // (igualdad de condiciones); las tareas lo copian de la plantilla
+    std::cout << "Inicializando disco (" << (config.ocupacion_inicial * 100) << "% ocupado)...\n";
+    MapaDeBits plantilla(config.total_bloques, config.tamanio_bloque);
+    plantilla.inicializar_disco(config.ocupacion_inicial, semilla);
+    plantilla.guardar_estado("data/disco_inicial.bin");
+    bool exportar_texto = config.total_bloques <= LIMITE_EXPORTAR_TEXTO;
+    if (exportar_texto)
+        plantilla.guardar_estado("data/disco_inicial.txt", TEXTO);
+
+    // Traza opcional de una tarea, para reproducirla con --modo reproducir
+    std::unique_ptr<GrabadorTraza> grabador;
+    if (!config.traza.empty())
+    {
+        grabador = std::make_unique<GrabadorTraza>(config.traza, config.total_bloques, config.tamanio_bloque);
+        if (!grabador->abierto())
+            return 1;
+    }
+
     // ========================================================================
-    // LOOP PRINCIPAL: 5 CORRIDAS
+    // CORRIDAS × ESTRUCTURAS EN EL POOL DE HILOS
     // ========================================================================
+    std::vector<std::vector<ResultadoEstructura>> todas_corridas =
+        correr_corridas(config, plantilla, semilla, NUM_CORRIDAS, config.hilos, grabador.get());
+
+    // Mostrar y guardar en orden
     for (int corrida = 1; corrida <= NUM_CORRIDAS; corrida++)
     {
-        std::cout << "\nCorrida " << corrida << " de " << NUM_CORRIDAS << "\n\n";
-
-        std::vector<ResultadoEstructura> resultados_corrida;
+        std::cout << "\nCorrida " << corrida << " de " << NUM_CORRIDAS << "\n";
 
-        // Crear las 3 estructuras
-        std::vector<std::unique_ptr<GestorDisco>> gestores;
-        gestores.push_back(std::make_unique<MapaDeBits>());
-        gestores.push_back(std::make_unique<ListaSimple>());
-        gestores.push_back(std::make_unique<ListaDoble>());
-
-        // Inicializar todos con el mismo estado (70% ocupado)
-        std::cout << "Inicializando disco (" << (OCUPACION_INICIAL * 100) << "% ocupado)...\n";
-            // Generar un estado inicial único y cargarlo en cada estructura
-            MapaDeBits tmp;
-            tmp.inicializar_disco(OCUPACION_INICIAL);
-            // Guardar el estado inicial la primera vez
-            if (corrida == 1)
-            {
-                tmp.guardar_estado("data/disco_inicial.txt");
-            }
-
-            // Cargar el mismo estado en cada gestor para asegurar igualdad de condiciones
-            for (auto &gestor : gestores)
-            {
-                gestor->cargar_estado("data/disco_inicial.txt");
-            }
-
-        // Ejecutar pruebas para cada estructura
-        for (auto &gestor : gestores)
+        for (const auto &resultado : todas_corridas[corrida - 1])
         {
-            std::cout << "\n--- " << gestor->obtener_nombre() << " ---\n";
-
-            ResultadoEstructura resultado = ejecutar_secuencia_pruebas(gestor.get());
-            resultados_corrida.push_back(resultado);
+            std::cout << "\n--- " << resultado.nombre << " ---\n" << resultado.registro;
         }
 
-        // Guardar resultados de esta corrida
-        guardar_resultados(resultados_corrida, corrida);
-        todas_corridas.push_back(resultados_corrida);
-
+        guardar_resultados(todas_corridas[corrida - 1], corrida);
         std::cout << "\nCorrida " << corrida << " completada\n";
     }
 
+    // Con más de un hilo: repetir todo en serie y exigir las mismas decisiones
+    if (config.hilos > 1)
+    {
+        std::cout << "\nVerificando serie vs paralelo...\n";
+        auto en_serie = correr_corridas(config, plantilla, semilla, NUM_CORRIDAS, 1);
+        int diferencias = contar_diferencias(todas_corridas, en_serie);
+        if (diferencias != 0)
+        {
+            std::cout << "ERROR: " << diferencias << " tareas con decisiones distintas\n";
+            return 1;
+        }
+        std::cout << "Decisiones idénticas en las " << NUM_CORRIDAS * NUM_ESTRUCTURAS
+                  << " tareas (" << config.hilos << " hilos vs 1)\n";
+    }
+
     // ========================================================================
     // RESUMEN FINAL
     // ========================================================================
     imprimir_resumen_final(todas_corridas);
 
     std::cout << "Resultados guardados en: data/resultados.txt\n";
-    std::cout << "Estado inicial guardado en: data/disco_inicial.txt\n";
+    std::cout << "Estado inicial guardado en: data/disco_inicial.bin"
+              << (exportar_texto ? " (texto: data/disco_inicial.txt)" : "") << "\n";
+    if (grabador)
+    {
+        if (!grabador->cerrar())
+        {
+            std::cerr << "Error al escribir la traza (quedó incompleta): " << config.traza << "\n";
+            return 1;
+        }
+        std::cout << "Traza (corrida 1, " << todas_corridas[0][0].nombre << ", "
+                  << grabador->get_registros() << " operaciones) guardada en: " << config.traza << "\n"
+                  << "  Reproducir con: --modo reproducir --traza " << config.traza
+                  << " --estado data/disco_inicial.bin\n";
+    }
     std::cout << "\nSimulación completada exitosamente.\n\n";
 
     return 0;
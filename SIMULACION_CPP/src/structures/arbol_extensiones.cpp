@@ -0,0 +1,168 @@
+/*
+ * arbol_extensiones.cpp
+ *
+ * Implementación del gestor por extensiones: los huecos libres viven en
+ * dos árboles balanceados (std::map / std::set), uno ordenado por
+ * posición y otro por tamaño.
+ */
+
+#include "./core/disk_manager.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+// Constructor: los índices salen de reconstruir()
+
+ArbolExtensiones::ArbolExtensiones(IndiceBloque total_bloques, int tamanio_bloque)
+    : GestorDisco(total_bloques, tamanio_bloque)
+{
+    reconstruir();
+}
+
+// reconstruir: los huecos llegan ordenados por inicio, así que en
+// por_inicio se insertan con pista al final (O(1) amortizado); por_tamanio
+// sigue costando O(log h) cada uno. No usa el histograma: el mayor hueco
+// sale de por_tamanio.
+
+void ArbolExtensiones::reconstruir()
+{
+    por_inicio.clear();
+    por_tamanio.clear();
+
+    auto agregar = [&](IndiceBloque inicio, IndiceBloque tamanio)
+    {
+        por_inicio.emplace_hint(por_inicio.end(), inicio, tamanio);
+        por_tamanio.insert({tamanio, inicio});
+    };
+    disco.recorrer_rachas_libres(0, total_bloques, agregar);
+}
+
+// insertar_extension / quitar_extension: mantener ambos índices sincronizados
+
+void ArbolExtensiones::insertar_extension(IndiceBloque inicio, IndiceBloque tamanio)
+{
+    por_inicio[inicio] = tamanio;
+    por_tamanio.insert({tamanio, inicio});
+}
+
+void ArbolExtensiones::quitar_extension(std::map<IndiceBloque, IndiceBloque>::iterator it)
+{
+    por_tamanio.erase({it->second, it->first});
+    por_inicio.erase(it);
+}
+
+// ============================================================================
+// ALLOCAR (Best Fit en O(log n))
+//
+// lower_bound({N, -inf}) en por_tamanio devuelve el hueco más pequeño que
+// sirve; entre huecos del mismo tamaño, el de menor inicio (igual que el
+// recorrido de las listas ordenadas por posición).
+// ============================================================================
+
+IndiceBloque ArbolExtensiones::allocar(IndiceBloque num_bloques)
+{
+    auto mejor = por_tamanio.lower_bound({num_bloques, std::numeric_limits<IndiceBloque>::min()});
+    if (mejor == por_tamanio.end())
+    {
+        return -1; // No hay espacio suficiente
+    }
+
+    IndiceBloque tamanio = mejor->first;
+    IndiceBloque inicio = mejor->second;
+
+    quitar_extension(por_inicio.find(inicio));
+    if (tamanio > num_bloques)
+    {
+        // Sobrante: el resto del hueco sigue libre
+        insertar_extension(inicio + num_bloques, tamanio - num_bloques);
+    }
+
+    disco.marcar_rango(inicio, num_bloques);
+    bloques_ocupados += num_bloques;
+    bloques_libres -= num_bloques;
+
+    // Cobrar la escritura ya con la posición conocida
+    simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+
+    return inicio;
+}
+
+// ============================================================================
+// LIBERAR (coalescencia solo con los vecinos)
+//
+// EJEMPLO:
+// huecos: [10-14] [20-22]     liberar [15-19]
+// → el anterior (10) termina en 15 y el siguiente (20) empieza en 20
+// → un solo hueco [10-22]
+//
+// Si el rango se superpone con huecos existentes (bloques que ya estaban
+// libres), también se absorben.
+// ============================================================================
+
+bool ArbolExtensiones::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
+    {
+        return false;
+    }
+
+    simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+    IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+    bloques_ocupados -= liberados;
+    bloques_libres += liberados;
+
+    IndiceBloque nuevo_inicio = inicio;
+    IndiceBloque nuevo_fin = inicio + num_bloques; // Exclusivo
+
+    // Vecino anterior: el último hueco que empieza antes del rango
+    auto it = por_inicio.lower_bound(inicio);
+    if (it != por_inicio.begin())
+    {
+        auto anterior = std::prev(it);
+        if (anterior->first + anterior->second >= inicio)
+        {
+            nuevo_inicio = anterior->first;
+            nuevo_fin = std::max(nuevo_fin, anterior->first + anterior->second);
+            quitar_extension(anterior);
+        }
+    }
+
+    // Vecinos siguientes: los que empiezan dentro o justo al final del rango
+    while (it != por_inicio.end() && it->first <= nuevo_fin)
+    {
+        nuevo_fin = std::max(nuevo_fin, it->first + it->second);
+        auto siguiente = std::next(it);
+        quitar_extension(it);
+        it = siguiente;
+    }
+
+    insertar_extension(nuevo_inicio, nuevo_fin - nuevo_inicio);
+
+    return true;
+}
+
+// get_mayor_hueco: O(1), último elemento del índice por tamaño
+// (el índice ya hace de histograma, no se usa el de la clase base)
+
+IndiceBloque ArbolExtensiones::get_mayor_hueco() const
+{
+    if (por_tamanio.empty())
+        return 0;
+    return por_tamanio.rbegin()->first;
+}
+
+IndiceBloque ArbolExtensiones::buscar_bloque_mas_grande()
+{
+    simular_acceso_disco(BUSQUEDA, -1, 0);
+
+    return get_mayor_hueco();
+}
+
+// uso_memoria: cada hueco es un nodo en cada uno de los dos árboles
+
+size_t ArbolExtensiones::uso_memoria() const
+{
+    return por_inicio.size() * (SOBRECARGA_NODO_ARBOL + sizeof(std::pair<const IndiceBloque, IndiceBloque>)) +
+           por_tamanio.size() * (SOBRECARGA_NODO_ARBOL + sizeof(std::pair<IndiceBloque, IndiceBloque>));
+}
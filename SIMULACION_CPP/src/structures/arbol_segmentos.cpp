@@ -0,0 +1,275 @@
+/*
+ * arbol_segmentos.cpp
+ *
+ * Implementación de un árbol de segmentos para la gestión de bloques.
+ * Cada nodo guarda {prefijo libre, sufijo libre, racha libre máxima} de
+ * su rango; las actualizaciones de rango usan propagación perezosa.
+ */
+
+#include "./core/disk_manager.h"
+#include <algorithm>
+
+// Constructor: construir el árbol a partir del disco
+
+ArbolSegmentos::ArbolSegmentos(IndiceBloque total_bloques, int tamanio_bloque)
+    : GestorDisco(total_bloques, tamanio_bloque), hojas(1)
+{
+    // Redondear a potencia de 2; las hojas sobrantes cuentan como ocupadas
+    while (hojas < total_bloques)
+    {
+        hojas <<= 1;
+    }
+
+    prefijo.assign(2 * hojas, 0);
+    sufijo.assign(2 * hojas, 0);
+    maximo.assign(2 * hojas, 0);
+    pendiente.assign(2 * hojas, NINGUNO);
+
+    reconstruir();
+}
+
+// ============================================================================
+// RECONSTRUIR
+//
+// PROPÓSITO:
+// Rehacer el árbol desde `disco` leyendo palabras, no bits.
+//
+// CÓMO (de abajo hacia arriba):
+// 1. Cada nodo que cubre 64 hojas alineadas corresponde a una palabra:
+//    - palabra toda libre u ocupada → aplicar() con marca perezosa, sin
+//      tocar las 127 posiciones de su subárbol
+//    - palabra mezclada → llenar sus 64 hojas y combinar sus 6 niveles
+// 2. Los niveles de arriba se combinan en orden (O(palabras))
+//
+// Las hojas más allá de total_bloques salen del relleno sellado del
+// bitmap (o de palabras que no existen): cuentan como ocupadas.
+//
+// COMPLEJIDAD: O(palabras + 64 · palabras mezcladas); en un disco muy
+// fragmentado sigue siendo O(n), el tamaño del propio árbol.
+// ============================================================================
+
+void ArbolSegmentos::reconstruir()
+{
+    // Hojas por palabra (un disco de menos de 64 bloques es un solo grupo)
+    IndiceBloque grupo = std::min<IndiceBloque>(hojas, BitmapPalabras::BITS_POR_PALABRA);
+    IndiceBloque grupos = hojas / grupo;
+    uint64_t todos = (grupo == BitmapPalabras::BITS_POR_PALABRA) ? ~0ULL : (1ULL << grupo) - 1;
+    const uint64_t *palabras = disco.datos();
+
+    for (IndiceBloque g = 0; g < grupos; g++)
+    {
+        uint64_t ocupados = (g < disco.num_palabras()) ? palabras[g] & todos : todos;
+        IndiceBloque nodo = grupos + g; // Raíz del subárbol de esta palabra
+
+        if (ocupados == 0 || ocupados == todos)
+        {
+            aplicar(nodo, grupo, ocupados == 0 ? TODO_LIBRE : TODO_OCUPADO);
+            continue;
+        }
+
+        IndiceBloque primera_hoja = nodo * grupo;
+        for (IndiceBloque b = 0; b < grupo; b++)
+        {
+            IndiceBloque libre = ((ocupados >> b) & 1ULL) ? 0 : 1;
+            prefijo[primera_hoja + b] = sufijo[primera_hoja + b] = maximo[primera_hoja + b] = libre;
+            pendiente[primera_hoja + b] = NINGUNO;
+        }
+        for (IndiceBloque largo = 2; largo <= grupo; largo *= 2)
+        {
+            for (IndiceBloque i = nodo * (grupo / largo); i < (nodo + 1) * (grupo / largo); i++)
+            {
+                pendiente[i] = NINGUNO;
+                combinar(i, largo / 2, largo / 2);
+            }
+        }
+    }
+
+    for (IndiceBloque largo = 2 * grupo; largo <= hojas; largo *= 2)
+    {
+        for (IndiceBloque i = hojas / largo; i < 2 * (hojas / largo); i++)
+        {
+            pendiente[i] = NINGUNO;
+            combinar(i, largo / 2, largo / 2);
+        }
+    }
+}
+
+// ============================================================================
+// COMBINAR
+//
+// PROPÓSITO:
+// Calcular los valores de un nodo a partir de sus dos hijos.
+//
+// EJEMPLO:
+// izq = [0 0 1 0]  pre:2 suf:1 max:2
+// der = [0 0 0 1]  pre:3 suf:0 max:3
+// padre:           pre:2 suf:0 max: max(2, 3, 1+3) = 4  ← cruza el medio
+// ============================================================================
+
+void ArbolSegmentos::combinar(IndiceBloque nodo, IndiceBloque largo_izq, IndiceBloque largo_der)
+{
+    IndiceBloque izq = 2 * nodo;
+    IndiceBloque der = 2 * nodo + 1;
+
+    prefijo[nodo] = (prefijo[izq] == largo_izq) ? largo_izq + prefijo[der] : prefijo[izq];
+    sufijo[nodo] = (sufijo[der] == largo_der) ? largo_der + sufijo[izq] : sufijo[der];
+    maximo[nodo] = std::max({maximo[izq], maximo[der], sufijo[izq] + prefijo[der]});
+}
+
+// aplicar: dejar un rango completo libre u ocupado y anotar la marca perezosa
+
+void ArbolSegmentos::aplicar(IndiceBloque nodo, IndiceBloque largo, Pendiente valor)
+{
+    IndiceBloque libres = (valor == TODO_LIBRE) ? largo : 0;
+    prefijo[nodo] = sufijo[nodo] = maximo[nodo] = libres;
+    pendiente[nodo] = valor;
+}
+
+// propagar: bajar la marca perezosa a los hijos antes de visitarlos
+
+void ArbolSegmentos::propagar(IndiceBloque nodo, IndiceBloque largo)
+{
+    if (pendiente[nodo] == NINGUNO)
+        return;
+
+    aplicar(2 * nodo, largo / 2, pendiente[nodo]);
+    aplicar(2 * nodo + 1, largo / 2, pendiente[nodo]);
+    pendiente[nodo] = NINGUNO;
+}
+
+// asignar_rango: marcar [desde, hasta] (inclusive) en O(log n)
+
+void ArbolSegmentos::asignar_rango(IndiceBloque nodo, IndiceBloque izq, IndiceBloque der,
+                                   IndiceBloque desde, IndiceBloque hasta, Pendiente valor)
+{
+    if (hasta < izq || der < desde)
+        return; // Sin intersección
+
+    if (desde <= izq && der <= hasta)
+    {
+        aplicar(nodo, der - izq + 1, valor); // Rango cubierto por completo
+        return;
+    }
+
+    propagar(nodo, der - izq + 1);
+    IndiceBloque medio = (izq + der) / 2;
+    asignar_rango(2 * nodo, izq, medio, desde, hasta, valor);
+    asignar_rango(2 * nodo + 1, medio + 1, der, desde, hasta, valor);
+    combinar(nodo, medio - izq + 1, der - medio);
+}
+
+// ============================================================================
+// BUSCAR_PRIMER_AJUSTE
+//
+// PROPÓSITO:
+// Encontrar la primera posición con N bloques libres consecutivos.
+//
+// ALGORITMO (bajar desde la raíz):
+// 1. Si el hijo izquierdo tiene una racha >= N → bajar a la izquierda
+// 2. Si la racha que cruza el medio (sufijo izq + prefijo der) >= N
+//    → empieza en medio + 1 - sufijo izq
+// 3. Si no → bajar a la derecha
+//
+// COMPLEJIDAD: O(log n)
+// ============================================================================
+
+IndiceBloque ArbolSegmentos::buscar_primer_ajuste(IndiceBloque num_bloques)
+{
+    if (maximo[1] < num_bloques)
+        return -1;
+
+    IndiceBloque nodo = 1;
+    IndiceBloque izq = 0;
+    IndiceBloque der = hojas - 1;
+
+    while (izq != der)
+    {
+        propagar(nodo, der - izq + 1);
+        IndiceBloque medio = (izq + der) / 2;
+        IndiceBloque hijo_izq = 2 * nodo;
+
+        if (maximo[hijo_izq] >= num_bloques)
+        {
+            nodo = hijo_izq;
+            der = medio;
+        }
+        else if (sufijo[hijo_izq] + prefijo[hijo_izq + 1] >= num_bloques)
+        {
+            return medio + 1 - sufijo[hijo_izq];
+        }
+        else
+        {
+            nodo = hijo_izq + 1;
+            izq = medio + 1;
+        }
+    }
+
+    return izq;
+}
+
+// allocar: primer ajuste + marcar rango ocupado
+
+IndiceBloque ArbolSegmentos::allocar(IndiceBloque num_bloques)
+{
+    IndiceBloque inicio = buscar_primer_ajuste(num_bloques);
+    if (inicio == -1)
+    {
+        return -1; // No hay espacio suficiente
+    }
+
+    asignar_rango(1, 0, hojas - 1, inicio, inicio + num_bloques - 1, TODO_OCUPADO);
+    disco.marcar_rango(inicio, num_bloques);
+
+    bloques_ocupados += num_bloques;
+    bloques_libres -= num_bloques;
+
+    // Cobrar la escritura ya con la posición conocida
+    simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+
+    return inicio;
+}
+
+// liberar: marcar rango libre; la unión con huecos vecinos es implícita
+
+bool ArbolSegmentos::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
+    {
+        return false;
+    }
+
+    simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+    // Solo cuentan los bloques que estaban ocupados
+    IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+    bloques_ocupados -= liberados;
+    bloques_libres += liberados;
+
+    asignar_rango(1, 0, hojas - 1, inicio, inicio + num_bloques - 1, TODO_LIBRE);
+
+    return true;
+}
+
+// get_mayor_hueco: O(1), el valor está en la raíz (la marca perezosa de
+// la raíz nunca queda sin aplicar en su propio nodo)
+
+IndiceBloque ArbolSegmentos::get_mayor_hueco() const
+{
+    return maximo[1];
+}
+
+IndiceBloque ArbolSegmentos::buscar_bloque_mas_grande()
+{
+    simular_acceso_disco(BUSQUEDA, -1, 0);
+
+    return get_mayor_hueco();
+}
+
+// uso_memoria: tres enteros y una marca por nodo, 2 × hojas nodos (no
+// depende de cuántos huecos haya)
+
+size_t ArbolSegmentos::uso_memoria() const
+{
+    return (prefijo.capacity() + sufijo.capacity() + maximo.capacity()) * sizeof(IndiceBloque) +
+           pendiente.capacity() * sizeof(Pendiente);
+}
@@ -6,144 +6,129 @@
  */
 
 #include "./core/disk_manager.h"
+#include "./core/construccion_listas.h"
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <map>
 
-// Constructor: similar a ListaSimple, pero con puntero a cola
+// Constructor: similar a ListaSimple, la lista sale de reconstruir()
 
-ListaDoble::ListaDoble() : GestorDisco(), cabeza(nullptr), cola(nullptr)
+ListaDoble::ListaDoble(IndiceBloque total_bloques, int tamanio_bloque)
+    : GestorDisco(total_bloques, tamanio_bloque), cabeza(nullptr), cola(nullptr)
 {
-    int inicio = -1;
-    int tamanio = 0;
+    reconstruir();
+}
 
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
-    {
-        if (!disco[i])
-        { // Libre
-            if (inicio == -1)
-            {
-                inicio = i;
-                tamanio = 1;
-            }
-            else
-            {
-                tamanio++;
-            }
-        }
-        else
-        { // Ocupado
-            if (inicio != -1)
-            {
-                insertar_ordenado(inicio, tamanio);
-                inicio = -1;
-                tamanio = 0;
-            }
-        }
-    }
+// reconstruir: como en ListaSimple (construccion_listas.h), enlazando
+// también `anterior` y dejando `cola` en el último hueco
 
-    if (inicio != -1)
+void ListaDoble::reconstruir()
+{
+    auto enlazar = [](NodoDoble *a, NodoDoble *b)
     {
-        insertar_ordenado(inicio, tamanio);
-    }
+        a->siguiente = b;
+        b->anterior = a;
+    };
+    cabeza = construir_lista_en_bloque(disco, total_bloques, pool, histograma_huecos, cola, enlazar);
 }
 
-// Destructor
+// Destructor: los nodos viven en las losas del pool, que se liberan
+// juntas al destruirlo (no hace falta recorrer la lista)
 
 ListaDoble::~ListaDoble()
 {
-    NodoDoble *actual = cabeza;
-    while (actual != nullptr)
-    {
-        NodoDoble *siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
-    }
 }
 
-// insertar_ordenado: manejar casos especiales (inicio, final, medio)
+// ============================================================================
+// INSERTAR_Y_UNIR
+//
+// Igual que en ListaSimple (una pasada, solo se unen los vecinos), pero
+// aprovechando el doble enlace: si el hueco está en la mitad alta del
+// disco se recorre desde la cola hacia atrás. Con `desde` (nodo con
+// inicio <= `inicio`, lo pasa liberar_lote) se avanza desde ahí.
+// ============================================================================
 
-void ListaDoble::insertar_ordenado(int inicio, int tamanio)
+ListaDoble::NodoDoble *ListaDoble::insertar_y_unir(IndiceBloque inicio, IndiceBloque tamanio, NodoDoble *desde)
 {
-    NodoDoble *nuevo = new NodoDoble(inicio, tamanio);
+    long long visitados = 0;
+    NodoDoble *anterior = nullptr;  // Último nodo con inicio <= `inicio`
+    NodoDoble *siguiente = nullptr; // Primer nodo con inicio > `inicio`
 
-    // CASO 1: Lista vacía
-    if (cabeza == nullptr)
+    // Paso 1: buscar la posición desde el extremo más cercano
+    if (desde != nullptr)
     {
-        cabeza = nuevo;
-        cola = nuevo;
-        return;
+        anterior = desde;
+        siguiente = desde->siguiente;
+        while (siguiente != nullptr && siguiente->inicio <= inicio)
+        {
+            anterior = siguiente;
+            siguiente = siguiente->siguiente;
+            visitados++;
+        }
     }
-
-    // CASO 2: Insertar al inicio
-    if (inicio < cabeza->inicio)
+    else if (inicio >= total_bloques / 2)
     {
-        nuevo->siguiente = cabeza;
-        cabeza->anterior = nuevo; // ← NUEVA conexión bidireccional
-        cabeza = nuevo;
-        return;
+        anterior = cola;
+        while (anterior != nullptr && anterior->inicio > inicio)
+        {
+            siguiente = anterior;
+            anterior = anterior->anterior;
+            visitados++;
+        }
     }
-
-    // CASO 3: Insertar al final
-    if (inicio > cola->inicio)
+    else
     {
-        nuevo->anterior = cola;
-        cola->siguiente = nuevo;
-        cola = nuevo;
-        return;
+        siguiente = cabeza;
+        while (siguiente != nullptr && siguiente->inicio <= inicio)
+        {
+            anterior = siguiente;
+            siguiente = siguiente->siguiente;
+            visitados++;
+        }
     }
 
-    // CASO 4: Insertar en medio
-    NodoDoble *actual = cabeza;
-    while (actual->siguiente != nullptr && actual->siguiente->inicio < inicio)
+    // Paso 2: unir con el anterior o enlazar un nodo nuevo
+    NodoDoble *base;
+    if (anterior != nullptr && anterior->inicio + anterior->tamanio >= inicio)
     {
-        actual = actual->siguiente;
+        base = anterior;
+        retirar_hueco(base->tamanio);
+        base->tamanio = std::max(base->inicio + base->tamanio, inicio + tamanio) - base->inicio;
     }
-
-    // Conectar 4 punteros:
-    nuevo->siguiente = actual->siguiente;
-    nuevo->anterior = actual;
-
-    if (actual->siguiente != nullptr)
+    else
     {
-        actual->siguiente->anterior = nuevo;
-    }
-    actual->siguiente = nuevo;
-}
-
-// coalescencia: unir huecos adyacentes (uso de eliminar_nodo para eficiencia)
+        base = pool.crear(inicio, tamanio);
+        base->anterior = anterior;
+        base->siguiente = siguiente;
 
-void ListaDoble::coalescencia()
-{
-    if (cabeza == nullptr)
-        return;
+        if (anterior != nullptr)
+            anterior->siguiente = base;
+        else
+            cabeza = base;
 
-    NodoDoble *actual = cabeza;
+        if (siguiente != nullptr)
+            siguiente->anterior = base;
+        else
+            cola = base;
+    }
 
-    while (actual != nullptr && actual->siguiente != nullptr)
+    // Paso 3: absorber los siguientes que queden pegados (normalmente 0 o 1)
+    while (base->siguiente != nullptr && base->siguiente->inicio <= base->inicio + base->tamanio)
     {
-        if (actual->inicio + actual->tamanio == actual->siguiente->inicio)
-        {
-            // Adyacentes → unir
-            NodoDoble *temp = actual->siguiente;
-            actual->tamanio += temp->tamanio;
-            actual->siguiente = temp->siguiente;
+        NodoDoble *temp = base->siguiente;
+        retirar_hueco(temp->tamanio);
+        base->tamanio = std::max(base->inicio + base->tamanio, temp->inicio + temp->tamanio) - base->inicio;
+        eliminar_nodo(temp);
+        visitados++;
+    }
 
-            if (temp->siguiente != nullptr)
-            {
-                temp->siguiente->anterior = actual;
-            }
-            else
-            {
-                cola = actual; // Actualizar cola si eliminamos el último
-            }
+    registrar_hueco(base->tamanio);
 
-            delete temp;
-        }
-        else
-        {
-            actual = actual->siguiente;
-        }
-    }
+    nodos_visitados_liberacion += visitados;
+    liberaciones_medidas++;
+
+    return base;
 }
 
 // eliminar_nodo: remover un nodo considerando casos (único, cabeza, cola, medio)
@@ -158,7 +143,7 @@ void ListaDoble::eliminar_nodo(NodoDoble *nodo)
     {
         cabeza = nullptr;
         cola = nullptr;
-        delete nodo;
+        pool.destruir(nodo);
         return;
     }
 
@@ -170,7 +155,7 @@ void ListaDoble::eliminar_nodo(NodoDoble *nodo)
         {
             cabeza->anterior = nullptr;
         }
-        delete nodo;
+        pool.destruir(nodo);
         return;
     }
 
@@ -182,29 +167,29 @@ void ListaDoble::eliminar_nodo(NodoDoble *nodo)
         {
             cola->siguiente = nullptr;
         }
-        delete nodo;
+        pool.destruir(nodo);
         return;
     }
 
     // CASO 4: Eliminar nodo intermedio
     nodo->anterior->siguiente = nodo->siguiente;
     nodo->siguiente->anterior = nodo->anterior;
-    delete nodo;
+    pool.destruir(nodo);
 }
 
 // buscar_mejor_ajuste: algoritmo Best Fit (igual que lista simple)
 
-ListaDoble::NodoDoble *ListaDoble::buscar_mejor_ajuste(int num_bloques)
+ListaDoble::NodoDoble *ListaDoble::buscar_mejor_ajuste(IndiceBloque num_bloques)
 {
     NodoDoble *mejor = nullptr;
     NodoDoble *actual = cabeza;
-    int min_desperdicio = TOTAL_BLOQUES + 1;
+    IndiceBloque min_desperdicio = total_bloques + 1;
 
     while (actual != nullptr)
     {
         if (actual->tamanio >= num_bloques)
         {
-            int desperdicio = actual->tamanio - num_bloques;
+            IndiceBloque desperdicio = actual->tamanio - num_bloques;
             if (desperdicio < min_desperdicio)
             {
                 min_desperdicio = desperdicio;
@@ -219,9 +204,8 @@ ListaDoble::NodoDoble *ListaDoble::buscar_mejor_ajuste(int num_bloques)
 
 // allocar: similar a lista simple; eliminación de nodo es O(1) si aplica
 
-int ListaDoble::allocar(int num_bloques)
+IndiceBloque ListaDoble::allocar(IndiceBloque num_bloques)
 {
-    simular_acceso_disco(ALLOCACION, num_bloques);
     NodoDoble *nodo = buscar_mejor_ajuste(num_bloques);
 
     if (nodo == nullptr)
@@ -229,17 +213,17 @@ int ListaDoble::allocar(int num_bloques)
         return -1;
     }
 
-    int inicio = nodo->inicio;
+    IndiceBloque inicio = nodo->inicio;
 
     // Marcar bloques en el disco
-    for (int i = inicio; i < inicio + num_bloques; i++)
-    {
-        disco[i] = true;
-    }
+    disco.marcar_rango(inicio, num_bloques);
 
     bloques_ocupados += num_bloques;
     bloques_libres -= num_bloques;
 
+    retirar_hueco(nodo->tamanio);
+    registrar_hueco(nodo->tamanio - num_bloques);
+
     // Actualizar nodo
     if (nodo->tamanio == num_bloques)
     {
@@ -251,56 +235,140 @@ int ListaDoble::allocar(int num_bloques)
         nodo->tamanio -= num_bloques;
     }
 
+    // Cobrar la escritura ya con la posición conocida
+    simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+
     return inicio;
 }
 
-// liberar: marcar bloques libres, insertar segmento y coalescencia
+// liberar: marcar bloques libres e insertar el segmento uniéndolo con sus vecinos
 
-bool ListaDoble::liberar(int inicio, int num_bloques)
+bool ListaDoble::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
 {
-    if (inicio < 0 || inicio + num_bloques > TOTAL_BLOQUES)
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
     {
         return false;
     }
 
-    simular_acceso_disco(LIBERACION, num_bloques);
+    simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+    // Marcar bloques como libres (solo cuentan los que estaban ocupados)
+    IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+    bloques_ocupados -= liberados;
+    bloques_libres += liberados;
+
+    // Insertar segmento + coalescencia con vecinos (una sola pasada)
+    insertar_y_unir(inicio, num_bloques);
+
+    return true;
+}
+
+// ============================================================================
+// ALLOCAR_LOTE
+//
+// Mismo esquema que ListaSimple::allocar_lote (índice temporal
+// {tamaño, inicio} → nodo, resultado idéntico a allocar() uno por uno).
+// Con el doble enlace cada nodo agotado se quita en O(1) en el momento.
+// ============================================================================
+
+std::vector<IndiceBloque> ListaDoble::allocar_lote(const std::vector<IndiceBloque> &tamanios)
+{
+    if (tamanios.size() < LOTE_MINIMO_INDICE)
+    {
+        return GestorDisco::allocar_lote(tamanios);
+    }
+
+    std::map<std::pair<IndiceBloque, IndiceBloque>, NodoDoble *> por_tamanio;
+    for (NodoDoble *nodo = cabeza; nodo != nullptr; nodo = nodo->siguiente)
+    {
+        por_tamanio.emplace(std::make_pair(nodo->tamanio, nodo->inicio), nodo);
+    }
+
+    std::vector<IndiceBloque> resultados;
+    resultados.reserve(tamanios.size());
 
-    // Marcar bloques como libres
-    for (int i = inicio; i < inicio + num_bloques; i++)
+    for (IndiceBloque num_bloques : tamanios)
     {
-        if (disco[i])
+        auto it = por_tamanio.lower_bound({num_bloques, std::numeric_limits<IndiceBloque>::min()});
+        if (it == por_tamanio.end())
         {
-            disco[i] = false;
-            bloques_ocupados--;
-            bloques_libres++;
+            resultados.push_back(-1);
+            continue;
         }
-    }
 
-    // Insertar nuevo segmento
-    insertar_ordenado(inicio, num_bloques);
+        NodoDoble *nodo = it->second;
+        por_tamanio.erase(it);
+        IndiceBloque inicio = nodo->inicio;
 
-    // Coalescencia
-    coalescencia();
+        disco.marcar_rango(inicio, num_bloques);
+        bloques_ocupados += num_bloques;
+        bloques_libres -= num_bloques;
 
-    return true;
+        retirar_hueco(nodo->tamanio);
+        registrar_hueco(nodo->tamanio - num_bloques);
+
+        if (nodo->tamanio == num_bloques)
+        {
+            eliminar_nodo(nodo);
+        }
+        else
+        {
+            nodo->inicio += num_bloques;
+            nodo->tamanio -= num_bloques;
+            por_tamanio.emplace(std::make_pair(nodo->tamanio, nodo->inicio), nodo);
+        }
+
+        simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+        resultados.push_back(inicio);
+    }
+
+    return resultados;
 }
 
-// buscar_bloque_mas_grande: recorrer nodos y devolver el mayor tamaño
+// liberar_lote: ordenadas por inicio, cada inserción sigue desde el nodo
+// donde quedó la anterior (un solo barrido hacia adelante)
 
-int ListaDoble::buscar_bloque_mas_grande()
+size_t ListaDoble::liberar_lote(std::vector<Extension> extensiones)
 {
-    simular_acceso_disco(BUSQUEDA);
+    std::sort(extensiones.begin(), extensiones.end());
 
-    int max_tamanio = 0;
-    NodoDoble *actual = cabeza;
+    size_t liberadas = 0;
+    NodoDoble *ultimo = nullptr;
 
-    while (actual != nullptr)
+    for (const auto &[inicio, num_bloques] : extensiones)
     {
-        max_tamanio = std::max(max_tamanio, actual->tamanio);
-        actual = actual->siguiente;
+        if (inicio < 0 || inicio + num_bloques > total_bloques)
+        {
+            continue;
+        }
+
+        simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+        IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+        bloques_ocupados -= liberados;
+        bloques_libres += liberados;
+
+        ultimo = insertar_y_unir(inicio, num_bloques, ultimo);
+        liberadas++;
     }
 
-    return max_tamanio;
+    return liberadas;
+}
+
+// buscar_bloque_mas_grande: O(1) desde el histograma de huecos (igual que lista simple)
+
+IndiceBloque ListaDoble::buscar_bloque_mas_grande()
+{
+    simular_acceso_disco(BUSQUEDA, -1, 0);
+
+    return get_mayor_hueco();
+}
+
+// uso_memoria: las losas del pool (32 bytes por ranura) + el histograma
+
+size_t ListaDoble::uso_memoria() const
+{
+    return pool.bytes_reservados() + memoria_histograma();
 }
 
 // imprimir_lista: mostrar nodos con flechas bidireccionales
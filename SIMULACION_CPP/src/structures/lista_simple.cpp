@@ -7,134 +7,139 @@
  */
 
 #include "./core/disk_manager.h"
+#include "./core/construccion_listas.h"
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <map>
 
-// Constructor: construir la lista inicial de bloques libres a partir del disco
+// Constructor: la lista sale de reconstruir() (disco todo libre: un nodo)
 
-ListaSimple::ListaSimple() : GestorDisco(),
+ListaSimple::ListaSimple(IndiceBloque total_bloques, int tamanio_bloque)
+    : GestorDisco(total_bloques, tamanio_bloque),
                              cabeza(nullptr)
 {
-    int inicio = -1; // Marca el inicio de un segmento libre
-    int tamanio = 0; // Tamaño del segmento actual
+    reconstruir();
+}
 
-    // Recorrer todo el disco
-    for (int i = 0; i < TOTAL_BLOQUES; i++)
-    {
-        if (!disco[i])
-        { // Bloque LIBRE
-            if (inicio == -1)
-            {
-                // Inicio de un nuevo segmento libre
-                inicio = i;
-                tamanio = 1;
-            }
-            else
-            {
-                // Continuar el segmento actual
-                tamanio++;
-            }
-        }
-        else
-        { // Bloque OCUPADO
-            if (inicio != -1)
-            {
-                // Fin del segmento libre → crear nodo
-                insertar_ordenado(inicio, tamanio);
-                inicio = -1;
-                tamanio = 0;
-            }
-        }
-    }
+// ============================================================================
+// RECONSTRUIR
+//
+// PROPÓSITO:
+// Rehacer la lista desde `disco` (después de cargar o copiar un estado).
+//
+// CÓMO (ver construccion_listas.h):
+// recorrer_rachas_libres entrega los huecos ya ordenados por posición,
+// sacándolos de a 64 bloques por palabra; cada uno se engancha al final
+// con un puntero al último nodo, sin recorrer la lista. En discos
+// grandes el recorrido se reparte entre hilos por tramos y después se
+// cosen los bordes.
+//
+// COMPLEJIDAD: O(palabras + huecos), dividido por los hilos
+// ============================================================================
 
-    // Insertar último segmento si existe
-    if (inicio != -1)
-    {
-        insertar_ordenado(inicio, tamanio);
-    }
+void ListaSimple::reconstruir()
+{
+    Nodo *ultimo = nullptr;
+    auto enlazar = [](Nodo *a, Nodo *b)
+    { a->siguiente = b; };
+    cabeza = construir_lista_en_bloque(disco, total_bloques, pool, histograma_huecos, ultimo, enlazar);
 }
 
-// Destructor: liberar memoria de los nodos
+// Destructor: los nodos viven en las losas del pool, que se liberan
+// juntas al destruirlo (no hace falta recorrer la lista)
 
 ListaSimple::~ListaSimple()
 {
-    Nodo *actual = cabeza;
-    while (actual != nullptr)
-    {
-        Nodo *siguiente = actual->siguiente;
-        delete actual; // Liberar memoria del nodo
-        actual = siguiente;
-    }
 }
 
-// insertar_ordenado: insertar un nuevo nodo manteniendo la lista ordenada
+// ============================================================================
+// INSERTAR_Y_UNIR
+//
+// PROPÓSITO:
+// Insertar un hueco liberado y unirlo SOLO con sus vecinos, en una
+// única pasada (antes: inserción ordenada O(n) + coalescencia O(n)).
+//
+// EJEMPLO:
+// [10-14] → [20-22] → [40-49]        liberar [15-19]
+//   anterior  siguiente
+// 1. Recorrer hasta el primer nodo que empieza después de 15 ([20-22])
+// 2. ¿anterior termina en 15?  sí → extender [10-14] a [10-19]
+// 3. ¿siguiente empieza en 20? sí → absorber [20-22] → [10-22]
+// Resultado: [10-22] → [40-49]   (solo se tocaron 2 nodos + el recorrido)
+//
+// Si el rango se superpone con huecos que ya estaban libres, esos nodos
+// también se absorben.
+//
+// Con `desde` (un nodo con inicio <= `inicio`) el recorrido arranca ahí en
+// vez de en la cabeza: liberar_lote lo usa para no volver atrás.
+// ============================================================================
 
-void ListaSimple::insertar_ordenado(int inicio, int tamanio)
+ListaSimple::Nodo *ListaSimple::insertar_y_unir(IndiceBloque inicio, IndiceBloque tamanio, Nodo *desde)
 {
-    Nodo *nuevo = new Nodo(inicio, tamanio);
+    long long visitados = 0;
+    Nodo *anterior = desde;
+    Nodo *actual = desde != nullptr ? desde->siguiente : cabeza;
 
-    // CASO 1: Lista vacía o insertar al inicio
-    if (cabeza == nullptr || inicio < cabeza->inicio)
+    // Paso 1: buscar la posición (único recorrido)
+    while (actual != nullptr && actual->inicio <= inicio)
     {
-        nuevo->siguiente = cabeza;
-        cabeza = nuevo;
-        return;
+        anterior = actual;
+        actual = actual->siguiente;
+        visitados++;
     }
 
-    // CASO 2: Buscar posición de inserción
-    Nodo *actual = cabeza;
-    while (actual->siguiente != nullptr && actual->siguiente->inicio < inicio)
+    // Paso 2: unir con el anterior o crear un nodo nuevo
+    Nodo *base;
+    if (anterior != nullptr && anterior->inicio + anterior->tamanio >= inicio)
     {
-        actual = actual->siguiente;
+        base = anterior;
+        retirar_hueco(base->tamanio);
+        base->tamanio = std::max(base->inicio + base->tamanio, inicio + tamanio) - base->inicio;
+    }
+    else
+    {
+        base = pool.crear(inicio, tamanio);
+        base->siguiente = actual;
+        if (anterior == nullptr)
+            cabeza = base;
+        else
+            anterior->siguiente = base;
     }
 
-    // Insertar entre actual y actual->siguiente
-    nuevo->siguiente = actual->siguiente;
-    actual->siguiente = nuevo;
-}
-
-// coalescencia: unir bloques libres adyacentes en un único nodo
+    // Paso 3: absorber los siguientes que queden pegados (normalmente 0 o 1)
+    while (base->siguiente != nullptr && base->siguiente->inicio <= base->inicio + base->tamanio)
+    {
+        Nodo *temp = base->siguiente;
+        retirar_hueco(temp->tamanio);
+        base->tamanio = std::max(base->inicio + base->tamanio, temp->inicio + temp->tamanio) - base->inicio;
+        base->siguiente = temp->siguiente;
+        pool.destruir(temp);
+        visitados++;
+    }
 
-void ListaSimple::coalescencia()
-{
-    if (cabeza == nullptr)
-        return;
+    registrar_hueco(base->tamanio);
 
-    Nodo *actual = cabeza;
+    nodos_visitados_liberacion += visitados;
+    liberaciones_medidas++;
 
-    while (actual != nullptr && actual->siguiente != nullptr)
-    {
-        // Verificar si el siguiente nodo es adyacente
-        if (actual->inicio + actual->tamanio == actual->siguiente->inicio)
-        {
-            // ¡Son adyacentes! Unir nodos
-            Nodo *temp = actual->siguiente;
-            actual->tamanio += temp->tamanio;    // Sumar tamaños
-            actual->siguiente = temp->siguiente; // Saltar el nodo a eliminar
-            delete temp;                         // Liberar memoria
-            // No avanzar actual (puede haber más nodos adyacentes)
-        }
-        else
-        {
-            actual = actual->siguiente;
-        }
-    }
+    return base;
 }
 
 // buscar_mejor_ajuste (Best Fit): encontrar el hueco con menor desperdicio
 
-ListaSimple::Nodo *ListaSimple::buscar_mejor_ajuste(int num_bloques)
+ListaSimple::Nodo *ListaSimple::buscar_mejor_ajuste(IndiceBloque num_bloques)
 {
     Nodo *mejor = nullptr;
     Nodo *actual = cabeza;
-    int min_desperdicio = TOTAL_BLOQUES + 1;
+    IndiceBloque min_desperdicio = total_bloques + 1;
 
     // Recorrer toda la lista
     while (actual != nullptr)
     {
         if (actual->tamanio >= num_bloques)
         { // ¿Cabe?
-            int desperdicio = actual->tamanio - num_bloques;
+            IndiceBloque desperdicio = actual->tamanio - num_bloques;
             if (desperdicio < min_desperdicio)
             {
                 min_desperdicio = desperdicio;
@@ -154,15 +159,14 @@ ListaSimple::Nodo *ListaSimple::buscar_mejor_ajuste(int num_bloques)
 // Ocupar N bloques del disco usando la lista.
 //
 // PROCESO:
-// 1. Simular delay de I/O
-// 2. Buscar mejor hueco (Best Fit)
-// 3. Marcar bloques como ocupados en el disco real
-// 4. Actualizar o eliminar el nodo
+// 1. Buscar mejor hueco (Best Fit)
+// 2. Marcar bloques como ocupados en el disco real
+// 3. Actualizar o eliminar el nodo
+// 4. Cobrar el tiempo de I/O en el reloj virtual
 // ============================================================================
 
-int ListaSimple::allocar(int num_bloques)
+IndiceBloque ListaSimple::allocar(IndiceBloque num_bloques)
 {
-    simular_acceso_disco(ALLOCACION, num_bloques);
     Nodo *nodo = buscar_mejor_ajuste(num_bloques);
 
     if (nodo == nullptr)
@@ -170,24 +174,24 @@ int ListaSimple::allocar(int num_bloques)
         return -1; // No hay espacio suficiente
     }
 
-    int inicio = nodo->inicio;
+    IndiceBloque inicio = nodo->inicio;
 
     // Marcar bloques como ocupados en el disco real
-    for (int i = inicio; i < inicio + num_bloques; i++)
-    {
-        disco[i] = true;
-    }
+    disco.marcar_rango(inicio, num_bloques);
 
     bloques_ocupados += num_bloques;
     bloques_libres -= num_bloques;
 
+    retirar_hueco(nodo->tamanio);
+    registrar_hueco(nodo->tamanio - num_bloques);
+
     // Actualizar el nodo
     if (nodo->tamanio == num_bloques)
     {
         if (nodo == cabeza)
         {
             cabeza = cabeza->siguiente;
-            delete nodo;
+            pool.destruir(nodo);
         }
         else
         {
@@ -197,7 +201,7 @@ int ListaSimple::allocar(int num_bloques)
                 anterior = anterior->siguiente;
             }
             anterior->siguiente = nodo->siguiente;
-            delete nodo;
+            pool.destruir(nodo);
         }
     }
     else
@@ -206,6 +210,9 @@ int ListaSimple::allocar(int num_bloques)
         nodo->tamanio -= num_bloques;
     }
 
+    // Cobrar la escritura ya con la posición conocida
+    simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+
     return inicio;
 }
 
@@ -216,40 +223,154 @@ int ListaSimple::allocar(int num_bloques)
 // Marcar bloques como libres y agregar a la lista.
 //
 // PROCESO:
-// 1. Simular delay
+// 1. Cobrar el tiempo de I/O en el reloj virtual
 // 2. Marcar bloques como libres en el disco
-// 3. Insertar nuevo nodo en la lista
-// 4. Coalescencia (unir bloques adyacentes)
+// 3. Insertar el hueco uniéndolo con sus vecinos (una sola pasada)
 // ============================================================================
 
-bool ListaSimple::liberar(int inicio, int num_bloques)
+bool ListaSimple::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
 {
     // Validación
-    if (inicio < 0 || inicio + num_bloques > TOTAL_BLOQUES)
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
     {
         return false;
     }
 
-    simular_acceso_disco(LIBERACION, num_bloques);
+    simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+    // Marcar bloques como libres en el disco (solo cuentan los que estaban ocupados)
+    IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+    bloques_ocupados -= liberados;
+    bloques_libres += liberados;
+
+    // Insertar el segmento y unirlo con los huecos vecinos
+    insertar_y_unir(inicio, num_bloques);
+
+    return true;
+}
+
+// ============================================================================
+// ALLOCAR_LOTE
+//
+// PROPÓSITO:
+// Atender muchos pedidos sin recorrer la lista entera en cada uno.
+//
+// PROCESO:
+// 1. Una pasada arma un índice temporal {tamaño, inicio} → nodo
+// 2. Cada pedido: lower_bound da el mejor ajuste en O(log n); empatados
+//    gana el de menor inicio, el mismo que elige buscar_mejor_ajuste
+// 3. El nodo se achica y vuelve al índice; si se agota queda con tamaño
+//    0 (sacarlo de la lista simple exigiría buscar su anterior)
+// 4. Una pasada final desenlaza los nodos agotados
+//
+// Resultado idéntico a llamar allocar() pedido por pedido.
+// ============================================================================
+
+std::vector<IndiceBloque> ListaSimple::allocar_lote(const std::vector<IndiceBloque> &tamanios)
+{
+    if (tamanios.size() < LOTE_MINIMO_INDICE)
+    {
+        return GestorDisco::allocar_lote(tamanios);
+    }
+
+    // Paso 1: índice por {tamaño, inicio}
+    std::map<std::pair<IndiceBloque, IndiceBloque>, Nodo *> por_tamanio;
+    for (Nodo *nodo = cabeza; nodo != nullptr; nodo = nodo->siguiente)
+    {
+        por_tamanio.emplace(std::make_pair(nodo->tamanio, nodo->inicio), nodo);
+    }
 
-    // Marcar bloques como libres en el disco
-    for (int i = inicio; i < inicio + num_bloques; i++)
+    std::vector<IndiceBloque> resultados;
+    resultados.reserve(tamanios.size());
+    bool hay_agotados = false;
+
+    // Paso 2 y 3: atender cada pedido contra el índice
+    for (IndiceBloque num_bloques : tamanios)
     {
-        if (disco[i])
-        { // Solo si estaba ocupado
-            disco[i] = false;
-            bloques_ocupados--;
-            bloques_libres++;
+        auto it = por_tamanio.lower_bound({num_bloques, std::numeric_limits<IndiceBloque>::min()});
+        if (it == por_tamanio.end())
+        {
+            resultados.push_back(-1);
+            continue;
         }
+
+        Nodo *nodo = it->second;
+        por_tamanio.erase(it);
+        IndiceBloque inicio = nodo->inicio;
+
+        disco.marcar_rango(inicio, num_bloques);
+        bloques_ocupados += num_bloques;
+        bloques_libres -= num_bloques;
+
+        retirar_hueco(nodo->tamanio);
+        registrar_hueco(nodo->tamanio - num_bloques);
+
+        nodo->inicio += num_bloques;
+        nodo->tamanio -= num_bloques;
+        if (nodo->tamanio > 0)
+            por_tamanio.emplace(std::make_pair(nodo->tamanio, nodo->inicio), nodo);
+        else
+            hay_agotados = true;
+
+        simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+        resultados.push_back(inicio);
     }
 
-    // Insertar nuevo segmento libre en la lista
-    insertar_ordenado(inicio, num_bloques);
+    // Paso 4: desenlazar los agotados en una sola pasada
+    if (hay_agotados)
+    {
+        Nodo **enlace = &cabeza;
+        while (*enlace != nullptr)
+        {
+            Nodo *nodo = *enlace;
+            if (nodo->tamanio == 0)
+            {
+                *enlace = nodo->siguiente;
+                pool.destruir(nodo);
+            }
+            else
+            {
+                enlace = &nodo->siguiente;
+            }
+        }
+    }
 
-    // IMPORTANTE: Coalescencia para unir bloques adyacentes
-    coalescencia();
+    return resultados;
+}
 
-    return true;
+// ============================================================================
+// LIBERAR_LOTE
+//
+// Ordenadas por inicio, cada extensión cae en o después del nodo donde
+// quedó la anterior: insertar_y_unir sigue desde ahí y la lista completa
+// se recorre una sola vez para todo el lote.
+// ============================================================================
+
+size_t ListaSimple::liberar_lote(std::vector<Extension> extensiones)
+{
+    std::sort(extensiones.begin(), extensiones.end());
+
+    size_t liberadas = 0;
+    Nodo *ultimo = nullptr; // Nodo donde quedó la extensión anterior
+
+    for (const auto &[inicio, num_bloques] : extensiones)
+    {
+        if (inicio < 0 || inicio + num_bloques > total_bloques)
+        {
+            continue;
+        }
+
+        simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+        IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+        bloques_ocupados -= liberados;
+        bloques_libres += liberados;
+
+        ultimo = insertar_y_unir(inicio, num_bloques, ultimo);
+        liberadas++;
+    }
+
+    return liberadas;
 }
 
 // ============================================================================
@@ -258,24 +379,23 @@ bool ListaSimple::liberar(int inicio, int num_bloques)
 // PROPÓSITO:
 // Encontrar el nodo con el tamaño más grande.
 //
-// VENTAJA DE LA LISTA:
-// Solo recorre nodos de bloques libres (no todo el disco como bitmap).
+// O(1): cada cambio de tamaño de un nodo ya pasó por el histograma de
+// huecos (registrar_hueco / retirar_hueco), no hace falta recorrer.
 // ============================================================================
 
-int ListaSimple::buscar_bloque_mas_grande()
+IndiceBloque ListaSimple::buscar_bloque_mas_grande()
 {
-    simular_acceso_disco(BUSQUEDA);
+    simular_acceso_disco(BUSQUEDA, -1, 0);
 
-    int max_tamanio = 0;
-    Nodo *actual = cabeza;
+    return get_mayor_hueco();
+}
 
-    while (actual != nullptr)
-    {
-        max_tamanio = std::max(max_tamanio, actual->tamanio);
-        actual = actual->siguiente;
-    }
+// uso_memoria: las losas del pool de nodos (24 bytes por ranura) + el
+// histograma de huecos
 
-    return max_tamanio;
+size_t ListaSimple::uso_memoria() const
+{
+    return pool.bytes_reservados() + memoria_histograma();
 }
 
 // ============================================================================
@@ -0,0 +1,408 @@
+/*
+ * vector_extensiones.cpp
+ *
+ * Implementación de los huecos libres como dos vectores paralelos
+ * ordenados por posición (structure of arrays). Todas las búsquedas
+ * recorren memoria contigua.
+ */
+
+#include "./core/disk_manager.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+// Constructor: los arreglos salen de reconstruir()
+
+VectorExtensiones::VectorExtensiones(IndiceBloque total_bloques, int tamanio_bloque)
+    : GestorDisco(total_bloques, tamanio_bloque)
+{
+    reconstruir();
+}
+
+// reconstruir: un recorrido de `disco` por palabras; los huecos llegan
+// ya ordenados, así que basta con push_back. O(palabras + huecos)
+
+void VectorExtensiones::reconstruir()
+{
+    inicios.clear();
+    tamanios.clear();
+    histograma_huecos.clear();
+
+    auto agregar = [&](IndiceBloque inicio, IndiceBloque tamanio)
+    {
+        inicios.push_back(inicio);
+        tamanios.push_back(tamanio);
+        registrar_hueco(tamanio);
+    };
+    disco.recorrer_rachas_libres(0, total_bloques, agregar);
+}
+
+// ============================================================================
+// BUSCAR_MEJOR_AJUSTE (Best Fit)
+//
+// `tamanios` se recorre en bloques de BLOQUE_ESCANEO elementos:
+// 1. Dentro de cada bloque, reducción min del desperdicio (tamaño - N)
+//    visto como entero sin signo: los huecos que no sirven dan negativo
+//    y, sin signo, quedan enormes. Longitud fija y sin ramas → el
+//    compilador la vectoriza; target_clones genera además una copia AVX2
+//    elegida al arrancar.
+// 2. Si el mínimo del bloque mejora al actual, se recuerda el bloque.
+//    Un ajuste perfecto (tamaño == N) no se puede mejorar: se corta ahí.
+// 3. Al final, el primer índice con ese tamaño dentro del bloque
+//    recordado (el de menor inicio, igual que las listas).
+//
+// Retorna: índice del hueco, o tamanios.size() si ninguno sirve.
+// ============================================================================
+
+static const size_t BLOQUE_ESCANEO = 256;
+static const IndiceBloque SIN_AJUSTE = std::numeric_limits<IndiceBloque>::max();
+
+__attribute__((target_clones("avx2", "default")))
+static IndiceBloque minimo_que_sirve(const IndiceBloque *tam, IndiceBloque num_bloques)
+{
+    uint64_t menor_desperdicio = ~0ULL;
+    for (size_t i = 0; i < BLOQUE_ESCANEO; i++)
+    {
+        uint64_t desperdicio = static_cast<uint64_t>(tam[i] - num_bloques);
+        menor_desperdicio = desperdicio < menor_desperdicio ? desperdicio : menor_desperdicio;
+    }
+
+    // Desperdicio "negativo" → ningún hueco del bloque sirve
+    if (menor_desperdicio > static_cast<uint64_t>(SIN_AJUSTE))
+        return SIN_AJUSTE;
+    return num_bloques + static_cast<IndiceBloque>(menor_desperdicio);
+}
+
+size_t VectorExtensiones::buscar_mejor_ajuste(IndiceBloque num_bloques) const
+{
+    const IndiceBloque *tam = tamanios.data();
+    const size_t n = tamanios.size();
+
+    IndiceBloque mejor = SIN_AJUSTE;
+    size_t bloque_mejor = 0;
+    size_t i = 0;
+
+    for (; i + BLOQUE_ESCANEO <= n && mejor != num_bloques; i += BLOQUE_ESCANEO)
+    {
+        IndiceBloque minimo = minimo_que_sirve(tam + i, num_bloques);
+        if (minimo < mejor)
+        {
+            mejor = minimo;
+            bloque_mejor = i;
+        }
+    }
+
+    // Cola que no completa un bloque
+    for (; i < n && mejor != num_bloques; i++)
+    {
+        if (tam[i] >= num_bloques && tam[i] < mejor)
+        {
+            mejor = tam[i];
+            bloque_mejor = i;
+        }
+    }
+
+    if (mejor == SIN_AJUSTE)
+        return n;
+
+    return static_cast<size_t>(std::find(tam + bloque_mejor, tam + n, mejor) - tam);
+}
+
+// allocar: Best Fit; el hueco se achica o, si se usa completo, se elimina
+
+IndiceBloque VectorExtensiones::allocar(IndiceBloque num_bloques)
+{
+    size_t i = buscar_mejor_ajuste(num_bloques);
+    if (i == tamanios.size())
+    {
+        return -1; // No hay espacio suficiente
+    }
+
+    IndiceBloque inicio = inicios[i];
+    retirar_hueco(tamanios[i]);
+    registrar_hueco(tamanios[i] - num_bloques);
+
+    if (tamanios[i] == num_bloques)
+    {
+        inicios.erase(inicios.begin() + i);
+        tamanios.erase(tamanios.begin() + i);
+    }
+    else
+    {
+        // Sigue en la misma posición del orden: solo se corre el inicio
+        inicios[i] += num_bloques;
+        tamanios[i] -= num_bloques;
+    }
+
+    disco.marcar_rango(inicio, num_bloques);
+    bloques_ocupados += num_bloques;
+    bloques_libres -= num_bloques;
+
+    // Cobrar la escritura ya con la posición conocida
+    simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+
+    return inicio;
+}
+
+// ============================================================================
+// LIBERAR
+//
+// upper_bound sobre `inicios` (O(log n)) da el primer hueco que empieza
+// después del inicio del rango; el anterior es el candidato a unirse por
+// la izquierda. Los huecos absorbidos por la derecha se borran de una vez.
+// ============================================================================
+
+bool VectorExtensiones::liberar(IndiceBloque inicio, IndiceBloque num_bloques)
+{
+    if (inicio < 0 || inicio + num_bloques > total_bloques)
+    {
+        return false;
+    }
+
+    simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+    IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+    bloques_ocupados -= liberados;
+    bloques_libres += liberados;
+
+    size_t siguiente = std::upper_bound(inicios.begin(), inicios.end(), inicio) - inicios.begin();
+    IndiceBloque fin = inicio + num_bloques; // Exclusivo
+
+    // Elegir el hueco que crece, evitando mover elementos si se puede:
+    // 1. el anterior, si termina donde empieza el rango
+    // 2. el siguiente, si empieza donde termina el rango (se corre su inicio)
+    // 3. si no toca a ninguno, insertar uno nuevo (único caso con memmove)
+    size_t destino;
+    if (siguiente > 0 && inicios[siguiente - 1] + tamanios[siguiente - 1] >= inicio)
+    {
+        destino = siguiente - 1;
+        retirar_hueco(tamanios[destino]);
+        fin = std::max(fin, inicios[destino] + tamanios[destino]);
+    }
+    else if (siguiente < inicios.size() && inicios[siguiente] <= fin)
+    {
+        destino = siguiente;
+        retirar_hueco(tamanios[destino]);
+        fin = std::max(fin, inicios[destino] + tamanios[destino]);
+        inicios[destino] = inicio;
+        siguiente++;
+    }
+    else
+    {
+        destino = siguiente;
+        inicios.insert(inicios.begin() + destino, inicio);
+        tamanios.insert(tamanios.begin() + destino, 0);
+        siguiente++;
+    }
+
+    // Absorber los huecos siguientes que quedan pegados
+    size_t ultimo = siguiente;
+    while (ultimo < inicios.size() && inicios[ultimo] <= fin)
+    {
+        retirar_hueco(tamanios[ultimo]);
+        fin = std::max(fin, inicios[ultimo] + tamanios[ultimo]);
+        ultimo++;
+    }
+    inicios.erase(inicios.begin() + siguiente, inicios.begin() + ultimo);
+    tamanios.erase(tamanios.begin() + siguiente, tamanios.begin() + ultimo);
+
+    tamanios[destino] = fin - inicios[destino];
+    registrar_hueco(tamanios[destino]);
+
+    return true;
+}
+
+// ============================================================================
+// ALLOCAR_LOTE
+//
+// Índice temporal {tamaño, inicio} → posición en los vectores (mismo
+// criterio de empate que buscar_mejor_ajuste, resultado idéntico a
+// allocar() uno por uno). Los huecos agotados quedan con tamaño 0 y se
+// compactan todos juntos al final: un solo movimiento de memoria en vez
+// de un erase por hueco.
+// ============================================================================
+
+std::vector<IndiceBloque> VectorExtensiones::allocar_lote(const std::vector<IndiceBloque> &pedidos)
+{
+    if (pedidos.size() < LOTE_MINIMO_INDICE)
+    {
+        return GestorDisco::allocar_lote(pedidos);
+    }
+
+    std::map<std::pair<IndiceBloque, IndiceBloque>, size_t> por_tamanio;
+    for (size_t i = 0; i < inicios.size(); i++)
+    {
+        por_tamanio.emplace(std::make_pair(tamanios[i], inicios[i]), i);
+    }
+
+    std::vector<IndiceBloque> resultados;
+    resultados.reserve(pedidos.size());
+    bool hay_agotados = false;
+
+    for (IndiceBloque num_bloques : pedidos)
+    {
+        auto it = por_tamanio.lower_bound({num_bloques, std::numeric_limits<IndiceBloque>::min()});
+        if (it == por_tamanio.end())
+        {
+            resultados.push_back(-1);
+            continue;
+        }
+
+        size_t i = it->second;
+        por_tamanio.erase(it);
+        IndiceBloque inicio = inicios[i];
+
+        retirar_hueco(tamanios[i]);
+        registrar_hueco(tamanios[i] - num_bloques);
+        inicios[i] += num_bloques;
+        tamanios[i] -= num_bloques;
+
+        if (tamanios[i] > 0)
+            por_tamanio.emplace(std::make_pair(tamanios[i], inicios[i]), i);
+        else
+            hay_agotados = true;
+
+        disco.marcar_rango(inicio, num_bloques);
+        bloques_ocupados += num_bloques;
+        bloques_libres -= num_bloques;
+
+        simular_acceso_disco(ALLOCACION, inicio, num_bloques);
+        resultados.push_back(inicio);
+    }
+
+    // Compactar: una pasada sobre los dos vectores
+    if (hay_agotados)
+    {
+        size_t destino = 0;
+        for (size_t i = 0; i < tamanios.size(); i++)
+        {
+            if (tamanios[i] > 0)
+            {
+                inicios[destino] = inicios[i];
+                tamanios[destino] = tamanios[i];
+                destino++;
+            }
+        }
+        inicios.resize(destino);
+        tamanios.resize(destino);
+    }
+
+    return resultados;
+}
+
+// ============================================================================
+// LIBERAR_LOTE
+//
+// Las extensiones ordenadas se mezclan con los huecos (que ya están
+// ordenados) como en el paso de merge de mergesort, uniendo todo lo que
+// se toque o superponga. Vectores nuevos armados en O(huecos + lote) en
+// vez de un insert/erase con memmove por extensión.
+//
+// Histograma: un hueco viejo que no recibe nada no se toca; en cuanto
+// algo se le une se retira, y la racha resultante se registra al cerrarla.
+// ============================================================================
+
+size_t VectorExtensiones::liberar_lote(std::vector<Extension> extensiones)
+{
+    if (extensiones.size() < LOTE_MINIMO_INDICE)
+    {
+        return GestorDisco::liberar_lote(std::move(extensiones));
+    }
+
+    std::sort(extensiones.begin(), extensiones.end());
+
+    std::vector<IndiceBloque> nuevos_inicios;
+    std::vector<IndiceBloque> nuevos_tamanios;
+    nuevos_inicios.reserve(inicios.size() + extensiones.size());
+    nuevos_tamanios.reserve(inicios.size() + extensiones.size());
+
+    // Racha abierta [racha_inicio, racha_fin)
+    IndiceBloque racha_inicio = -1;
+    IndiceBloque racha_fin = -1;
+    bool viejo_intacto = false; // La racha es todavía un hueco viejo sin cambios
+
+    auto cerrar_racha = [&]()
+    {
+        if (racha_inicio == -1)
+            return;
+        if (!viejo_intacto)
+            registrar_hueco(racha_fin - racha_inicio);
+        nuevos_inicios.push_back(racha_inicio);
+        nuevos_tamanios.push_back(racha_fin - racha_inicio);
+    };
+
+    auto agregar = [&](IndiceBloque inicio, IndiceBloque fin, bool es_viejo)
+    {
+        if (racha_inicio != -1 && inicio <= racha_fin)
+        {
+            if (viejo_intacto)
+            {
+                retirar_hueco(racha_fin - racha_inicio);
+                viejo_intacto = false;
+            }
+            if (es_viejo)
+                retirar_hueco(fin - inicio);
+            racha_fin = std::max(racha_fin, fin);
+            return;
+        }
+
+        cerrar_racha();
+        racha_inicio = inicio;
+        racha_fin = fin;
+        viejo_intacto = es_viejo;
+    };
+
+    size_t liberadas = 0;
+    size_t h = 0; // Próximo hueco viejo
+    size_t e = 0; // Próxima extensión del lote
+
+    while (h < inicios.size() || e < extensiones.size())
+    {
+        bool tomar_viejo = e == extensiones.size() ||
+                           (h < inicios.size() && inicios[h] <= extensiones[e].first);
+        if (tomar_viejo)
+        {
+            agregar(inicios[h], inicios[h] + tamanios[h], true);
+            h++;
+            continue;
+        }
+
+        const auto &[inicio, num_bloques] = extensiones[e++];
+        if (inicio < 0 || inicio + num_bloques > total_bloques)
+        {
+            continue;
+        }
+
+        simular_acceso_disco(LIBERACION, inicio, num_bloques);
+
+        IndiceBloque liberados = disco.limpiar_rango(inicio, num_bloques);
+        bloques_ocupados -= liberados;
+        bloques_libres += liberados;
+
+        if (num_bloques > 0)
+            agregar(inicio, inicio + num_bloques, false);
+        liberadas++;
+    }
+    cerrar_racha();
+
+    inicios.swap(nuevos_inicios);
+    tamanios.swap(nuevos_tamanios);
+
+    return liberadas;
+}
+
+// buscar_bloque_mas_grande: O(1) desde el histograma de huecos
+
+IndiceBloque VectorExtensiones::buscar_bloque_mas_grande()
+{
+    simular_acceso_disco(BUSQUEDA, -1, 0);
+
+    return get_mayor_hueco();
+}
+
+// uso_memoria: la capacidad de los dos arreglos + el histograma
+
+size_t VectorExtensiones::uso_memoria() const
+{
+    return (inicios.capacity() + tamanios.capacity()) * sizeof(IndiceBloque) + memoria_histograma();
+}